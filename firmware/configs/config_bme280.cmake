@@ -19,6 +19,19 @@ add_definitions(
     -DHARDWARE_STA_STATUS_LED_PIN=GPIO_NUM_16
     -DHARDWARE_ALARM_STATUS_LED_PIN=GPIO_NUM_17
 
+    # LED Layout
+    # Digit 1: LED_1 -> LED_56 => start 0, length 56
+    # Digit 2: LED_57 -> LED_112 => start 56, length 56
+    # Upper Dot: LED_113 -> LED_116 => start 112, length 4
+    # Lower Dot: LED_117 -> LED_120 => start 116, length 4
+    # Digit 3: LED_121 -> LED_176 => start 120, length 56
+    # Digit 4: LED_177 -> LED_232 => start 176, length 56
+    -DHARDWARE_LAYOUT_DIGIT_OFFSETS=0,56,120,176
+    -DHARDWARE_LAYOUT_DOT_OFFSETS=112,116
+    -DHARDWARE_LAYOUT_DOT_LENGTH=4
+    -DHARDWARE_LAYOUT_LEDS_PER_SEGMENT=8
+    -DHARDWARE_LAYOUT_SEGMENT_ORDER=F,G,E,D,C,B,A
+
     # Beeper Config
     -DHARDWARE_BEEPER_PIN=13
 
@@ -58,7 +58,7 @@ const ConfigApiGetResult* getConfigAsJson(const char* lastKey)
     // if lastKey is nullptr, do not skip any key
     std::unique_ptr<char[]> buf;
 
-    ESP_LOGI(TAG, "lastkey=%s", lastKey == nullptr ? "nullptr" : lastKey);
+    ESP_LOGD(TAG, "lastkey=%s", lastKey == nullptr ? "nullptr" : lastKey);
 
     configs.callForEveryConfig([&](auto& config) {
         if (lastKey != nullptr && config.nvsName() != lastKey && !lastKeyReached)
@@ -66,7 +66,7 @@ const ConfigApiGetResult* getConfigAsJson(const char* lastKey)
 
         if (lastKey != nullptr && config.nvsName() == lastKey)
         {
-            ESP_LOGI(TAG, "lastKey reached");
+            ESP_LOGD(TAG, "lastKey reached");
             lastKeyReached = true;
         }
 
@@ -89,7 +89,7 @@ const ConfigApiGetResult* getConfigAsJson(const char* lastKey)
 
         if (doc.overflowed())
         {
-            ESP_LOGI(TAG, "Document overflowed, returning");
+            ESP_LOGD(TAG, "Document overflowed, returning");
             configApiGetResult.isLastKey = false;
             return true;
         }
@@ -113,14 +113,14 @@ const ConfigApiGetResult* getConfigAsJson(const char* lastKey)
 
     if (!configApiGetResult.isLastKey)
     {
-        ESP_LOGI(TAG, "Returning partial result, removing trailing parts");
+        ESP_LOGD(TAG, "Returning partial result, removing trailing parts");
         configApiGetResult.result->pop_back(); // remove trailing '}'
         *configApiGetResult.result += ","; // add trailing ',' for next batch
     }
 
     if (lastKey != nullptr)
     {
-        ESP_LOGI(TAG, "Returning partial result, removing previous parts");
+        ESP_LOGD(TAG, "Returning partial result, removing previous parts");
         configApiGetResult.result->erase(0, 1);
     }
 
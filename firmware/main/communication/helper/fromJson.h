@@ -44,6 +44,7 @@ std::enable_if_t<
         !std::is_same_v<T, cpputils::ColorHelper> &&
         !std::is_same_v<T, SecondaryBrightnessMode> &&
         !std::is_same_v<T, LedAnimationName> &&
+        !std::is_same_v<T, DigitTransition> &&
         !is_duration_v<T>
         , FromJsonReturnType>
 fromJson(ConfigWrapper<T>& config, const std::string_view value)
@@ -55,12 +56,13 @@ fromJson(ConfigWrapper<T>& config, const std::string_view value)
 template<typename T>
 std::enable_if_t<
         std::is_same_v<T, SecondaryBrightnessMode> ||
-        std::is_same_v<T, LedAnimationName>
+        std::is_same_v<T, LedAnimationName> ||
+        std::is_same_v<T, DigitTransition>
         , FromJsonReturnType>
 fromJson(ConfigWrapper<T>& config, const std::string_view value)
 {
     if (const auto res = parseEnum<T>::parse(value); res.has_value())
-        return configs.write_config(config, res.value());
+        return configutils::write_config(config, res.value());
     else
         return std::unexpected(std::format("Invalid value for {}: {} ({})", t_to_str<T>::str, value, res.error()));
 }
@@ -72,7 +74,7 @@ std::enable_if_t<
 fromJson(ConfigWrapper<T>& config, const std::string_view value)
 {
     if (const auto parsed = cpputils::fromString<int32_t>(value))
-        return configs.write_config(config, espchrono::seconds32{*parsed});
+        return configutils::write_config(config, espchrono::seconds32{*parsed});
     else
         return std::unexpected(std::format("Invalid value for duration: {}", value));
 }
@@ -84,7 +86,7 @@ std::enable_if_t<
 fromJson(ConfigWrapper<T>& config, const std::string_view value)
 {
     if (const auto parsed = cpputils::fromString<int32_t>(value))
-        return configs.write_config(config, espchrono::minutes32{*parsed});
+        return configutils::write_config(config, espchrono::minutes32{*parsed});
     else
         return std::unexpected(std::format("Invalid value for duration: {}", value));
 }
@@ -96,7 +98,7 @@ std::enable_if_t<
 fromJson(ConfigWrapper<T>& config, const std::string_view value)
 {
     if (const auto parsed = cpputils::fromString<int32_t>(value))
-        return configs.write_config(config, espchrono::milliseconds32{*parsed});
+        return configutils::write_config(config, espchrono::milliseconds32{*parsed});
     else
         return std::unexpected(std::format("Invalid value for duration: {}", value));
 }
@@ -107,7 +109,7 @@ std::enable_if_t<
         , FromJsonReturnType>
 fromJson(ConfigWrapper<T>& config, const std::string_view value)
 {
-    return configs.write_config(config, std::string{value});
+    return configutils::write_config(config, std::string{value});
 }
 
 template<typename T>
@@ -117,7 +119,7 @@ std::enable_if_t<
 fromJson(ConfigWrapper<T>& config, const std::string_view value)
 {
     if (cpputils::is_in(value, "true", "false"))
-        return configs.write_config(config, value == "true");
+        return configutils::write_config(config, value == "true");
     else
         return std::unexpected(std::format("Invalid value for bool: {}", value));
 }
@@ -133,7 +135,7 @@ std::enable_if_t<
 fromJson(ConfigWrapper<T>& config, const std::string_view value)
 {
     if (auto parsed = cpputils::fromString<T>(value))
-        return configs.write_config(config, *parsed);
+        return configutils::write_config(config, *parsed);
     else
         return std::unexpected(std::format("Invalid value for integral: {}", value));
 }
@@ -145,9 +147,9 @@ std::enable_if_t<
 fromJson(ConfigWrapper<T>& config, const std::string_view value)
 {
     if (value.empty() || value == "null")
-        return configs.write_config(config, std::nullopt);
+        return configutils::write_config(config, std::nullopt);
     else if (const auto parsed = wifi_stack::fromString<wifi_stack::mac_t>(value); parsed)
-        return configs.write_config(config, *parsed);
+        return configutils::write_config(config, *parsed);
     else
         return std::unexpected(parsed.error());
 }
@@ -159,7 +161,7 @@ std::enable_if_t<
 fromJson(ConfigWrapper<T>& config, const std::string_view value)
 {
     if (const auto parsed = wifi_stack::fromString<wifi_stack::ip_address_t>(value); parsed)
-        return configs.write_config(config, *parsed);
+        return configutils::write_config(config, *parsed);
     else
         return std::unexpected(parsed.error());
 }
@@ -171,7 +173,7 @@ std::enable_if_t<
 fromJson(ConfigWrapper<T>& config, const std::string_view value)
 {
     if (const auto parsed = wifi_stack::fromString<wifi_stack::mac_t>(value); parsed)
-        return configs.write_config(config, *parsed);
+        return configutils::write_config(config, *parsed);
     else
         return std::unexpected(parsed.error());
 }
@@ -185,7 +187,7 @@ std::enable_if_t<
 fromJson(ConfigWrapper<T>& config, const std::string_view value)
 {
     if (auto parsed = cpputils::fromString<std::underlying_type_t<T>>(value))
-        return configs.write_config(config, T(*parsed));
+        return configutils::write_config(config, T(*parsed));
     else
         return std::unexpected(std::format("could not parse {}", value));
 }
@@ -197,7 +199,7 @@ std::enable_if_t<
 fromJson(ConfigWrapper<T>& config, const std::string_view value)
 {
     if (auto parsed = cpputils::parseColor(value))
-        return configs.write_config(config, *parsed);
+        return configutils::write_config(config, *parsed);
     else
         return std::unexpected(std::format("could not parse {}", value));
 }
@@ -210,7 +212,7 @@ std::enable_if_t<
 fromJson(ConfigWrapper<T>& config, const std::string_view value)
 {
     if (value.empty() || value == "null")
-        return configs.write_config(config, std::nullopt);
+        return configutils::write_config(config, std::nullopt);
     else
     {
         return fromJson(config, value);
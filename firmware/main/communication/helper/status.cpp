@@ -4,8 +4,10 @@
 #include <ArduinoJson.h>
 #include <espchrono.h>
 #include <espwifistack.h>
+#include <recursivelockhelper.h>
 
 // local includes
+#include "communication/realtime.h"
 #include "communication/webserver_api.h"
 #include "peripheral/bme280.h"
 #include "peripheral/ledhelpers/ledanimation.h"
@@ -64,8 +66,24 @@ esp_err_t generateStatusJson(JsonObject& statusObj)
         }
         else
         {
+            // the render task updates the stats and the led manager under this lock
+            espcpputils::RecursiveLockHelper ledGuard{led_lock->handle};
+
             ledObj["fps"] = ledManager->getFps();
+            ledObj["skippedFrames"] = ledManager->getSkippedFrames();
+
+            const auto& stats = renderStats();
+            ledObj["frames"] = stats.frames;
+            ledObj["missedDeadlines"] = stats.missedDeadlines;
+            ledObj["frameTimeUs"] = stats.lastFrameTime.count();
+            ledObj["avgFrameTimeUs"] = stats.averageFrameTime.count();
+            ledObj["maxFrameTimeUs"] = stats.maxFrameTime.count();
+            ledObj["frameIntervalMs"] = std::chrono::duration_cast<std::chrono::milliseconds>(stats.frameInterval).count();
+            ledObj["frameRate"] = stats.frameInterval.count() ? 1000000 / stats.frameInterval.count() : 0;
             ledObj["brightness"] = ledManager->getBrightness();
+            ledObj["currentMa"] = ledManager->getCurrentMilliAmpere();
+            ledObj["currentLimitMa"] = ledManager->getMilliAmpereLimit();
+            ledObj["powerScale"] = ledManager->getPowerScale();
             ledObj["visible"] = ledManager->isVisible();
             if (animation::currentAnimation)
                 if (auto enumValue = animation::currentAnimation->getEnumValue(); enumValue)
@@ -96,6 +114,26 @@ esp_err_t generateStatusJson(JsonObject& statusObj)
         }
     }
 
+    if (ledmanager::led_lock)
+    {
+        espcpputils::RecursiveLockHelper ledGuard{ledmanager::led_lock->handle};
+
+        auto realtimeObj = statusObj.createNestedObject("realtime");
+
+        const auto& stats = realtime::stats();
+        realtimeObj["active"] = realtime::active();
+        if (stats.protocol)
+            realtimeObj["protocol"] = realtime::toString(*stats.protocol);
+        else
+            realtimeObj["protocol"] = nullptr;
+        realtimeObj["packets"] = stats.packets;
+        realtimeObj["frames"] = stats.frames;
+        realtimeObj["lost"] = stats.lost;
+        realtimeObj["invalid"] = stats.invalid;
+        realtimeObj["latencyP50Us"] = stats.latency.percentile(50);
+        realtimeObj["latencyP99Us"] = stats.latency.percentile(99);
+    }
+
     {
         auto bme280obj = statusObj.createNestedObject("bme280");
 
@@ -40,7 +40,8 @@ typename std::enable_if<
         !typeutils::is_optional_v<T> &&
         !std::is_same_v<T, cpputils::ColorHelper> &&
         !std::is_same_v<T, SecondaryBrightnessMode> &&
-        !std::is_same_v<T, LedAnimationName>
+        !std::is_same_v<T, LedAnimationName> &&
+        !std::is_same_v<T, DigitTransition>
         , FromJsonReturnType>::type
 toJson(const T& value, JsonDocument &doc)
 {
@@ -52,7 +53,8 @@ template<typename T>
 typename std::enable_if<
         !is_duration_v<T> &&
         (std::is_same_v<T, SecondaryBrightnessMode> ||
-         std::is_same_v<T, LedAnimationName>)
+         std::is_same_v<T, LedAnimationName> ||
+         std::is_same_v<T, DigitTransition>)
         , FromJsonReturnType>::type
 toJson(const T& value, JsonDocument &doc)
 {
@@ -11,6 +11,7 @@ constexpr const char * const TAG = "mDNS";
 
 // local includes
 #include "utils/config.h"
+#include "utils/configsubscription.h"
 #include "utils/global_lock.h"
 
 namespace mdns {
@@ -19,8 +20,10 @@ namespace {
 
 bool initialized{};
 
-std::string lastHostname;
-std::string lastName;
+// begin() applies the current names
+configutils::ConfigSubscription namesChanged{[](const ConfigWrapperInterface& config) {
+    return configutils::isAnyOf(config, configs.hostname, configs.customName);
+}, false};
 
 } // namespace
 
@@ -48,9 +51,6 @@ void begin()
         return;
     }
 
-    lastHostname = hostname;
-    lastName = name;
-
     mdns_txt_item_t txt_records[] {
         mdns_txt_item_t { .key = "name", .value = name.c_str() },
         mdns_txt_item_t { .key = "hostname", .value = hostname.c_str() },
@@ -73,31 +73,25 @@ void begin()
 
 void update()
 {
-    if (!initialized)
+    if (!initialized || !namesChanged.consume())
         return;
 
     espcpputils::RecursiveLockHelper guard{global::global_lock->handle};
 
-    if (const auto& currentHostname = configs.hostname.value(); lastHostname != currentHostname)
+    const auto& hostname = configs.hostname.value();
+    if (const auto res = mdns_hostname_set(hostname.c_str()); res != ESP_OK)
     {
-        if (const auto res = mdns_hostname_set(currentHostname.c_str()); res != ESP_OK)
-        {
-            ESP_LOGE(TAG, "mdns_hostname_set() \"%.*s\" failed with: %s", currentHostname.size(), currentHostname.data(), esp_err_to_name(res));
-            return;
-        }
-
-        lastHostname = currentHostname;
+        ESP_LOGE(TAG, "mdns_hostname_set() \"%.*s\" failed with: %s", hostname.size(), hostname.data(), esp_err_to_name(res));
+        namesChanged.markChanged();
+        return;
     }
 
-    if (const auto& currentName = configs.customName.value(); lastName != currentName)
+    const auto& name = configs.customName.value();
+    if (const auto res = mdns_instance_name_set(name.c_str()); res != ESP_OK)
     {
-        if (const auto res = mdns_instance_name_set(currentName.c_str()); res != ESP_OK)
-        {
-            ESP_LOGE(TAG, "mdns_instance_name_set() \"%.*s\" failed with: %s", currentName.size(), currentName.data(), esp_err_to_name(res));
-            return;
-        }
-
-        lastName = currentName;
+        ESP_LOGE(TAG, "mdns_instance_name_set() \"%.*s\" failed with: %s", name.size(), name.data(), esp_err_to_name(res));
+        namesChanged.markChanged();
+        return;
     }
 }
 
@@ -3,6 +3,7 @@
 constexpr const char * const TAG = "mqtt";
 
 // system includes
+#include <memory>
 #include <tuple>
 
 // 3rdparty lib includes
@@ -10,13 +11,16 @@ constexpr const char * const TAG = "mqtt";
 #include <lockingqueue.h>
 #include <numberparsing.h>
 #include <recursivelockhelper.h>
-#include <taskutils.h>
 #include <wrappers/mqtt_client.h>
 
 // local includes
 #include "communication/helper/status.h"
+#include "peripheral/ledmanager.h"
 #include "utils/config.h"
+#include "utils/configsubscription.h"
 #include "utils/global_lock.h"
+#include "utils/taskplacement.h"
+#include "utils/tasks.h"
 #include "communication/wifi.h"
 
 namespace mqtt {
@@ -42,6 +46,10 @@ std::string lastMqttUrl;
 std::optional<espchrono::millis_clock::time_point> lastMqttPublish;
 bool mqttHassPublished;
 
+configutils::ConfigSubscription mqttUrlChanged{[](const ConfigWrapperInterface& config) {
+    return configutils::isAnyOf(config, configs.mqttUrl);
+}};
+
 } // namespace
 
 namespace {
@@ -144,6 +152,7 @@ std::string format_error(esp_mqtt_error_codes_t* error_handle)
 
             // {mqttTopic}/{hostname}/set/light
             // {mqttTopic}/{hostname}/set/digits
+            // {mqttTopic}/{hostname}/set/notify
 
             if (std::get<0>(*entry).find(std::format("{}/{}/set/", configs.mqttTopic.value(), configs.hostname.value())) == 0)
             {
@@ -168,7 +177,7 @@ std::string format_error(esp_mqtt_error_codes_t* error_handle)
                         const auto effect = doc["effect"].as<std::string>();
                         if (const auto parsed = parseLedAnimationName(effect); parsed)
                         {
-                            configs.write_config(configs.ledAnimation, *parsed);
+                            configutils::write_config(configs.ledAnimation, *parsed);
                         }
                         else
                         {
@@ -179,14 +188,14 @@ std::string format_error(esp_mqtt_error_codes_t* error_handle)
                     if (doc.containsKey("state"))
                     {
                         const auto state = doc["state"].as<std::string>();
-                        configs.write_config(configs.ledAnimationEnabled, state == "ON");
+                        configutils::write_config(configs.ledAnimationEnabled, state == "ON");
                     }
 
                     if (doc.containsKey("brightness"))
                     {
                         if (const auto brightness = doc["brightness"].as<int>(); brightness >= 0 && brightness <= 255)
                         {
-                            configs.write_config(configs.ledBrightness, brightness);
+                            configutils::write_config(configs.ledBrightness, brightness);
                         }
                         else
                         {
@@ -202,19 +211,45 @@ std::string format_error(esp_mqtt_error_codes_t* error_handle)
                             const auto g = color["g"].as<uint8_t>();
                             const auto b = color["b"].as<uint8_t>();
 
-                            configs.write_config(configs.primaryColor, cpputils::ColorHelper{r, g, b});
-                            configs.write_config(configs.secondaryColor, cpputils::ColorHelper{r, g, b});
-                            configs.write_config(configs.tertiaryColor, cpputils::ColorHelper{r, g, b});
+                            configutils::write_config(configs.primaryColor, cpputils::ColorHelper{r, g, b});
+                            configutils::write_config(configs.secondaryColor, cpputils::ColorHelper{r, g, b});
+                            configutils::write_config(configs.tertiaryColor, cpputils::ColorHelper{r, g, b});
                         }
                     }
 
                     lastMqttPublish = std::nullopt;
+                    ledmanager::requestFrame();
                 }
                 else if (key == "digits")
                 {
-                    configs.write_config(configs.ledOverrideDigits, value);
+                    configutils::write_config(configs.ledOverrideDigits, value);
 
                     lastMqttPublish = std::nullopt;
+                    ledmanager::requestFrame();
+                }
+                else if (key == "notify")
+                {
+                    doc.clear();
+
+                    if (deserializeJson(doc, value) != DeserializationError::Ok)
+                    {
+                        ESP_LOGE(TAG, "mqtt_receive_handle: failed to deserialize json");
+                        continue;
+                    }
+
+                    // {"color": {"r": 0, "g": 0, "b": 255}, "duration": 2000}
+                    const auto color = doc["color"].as<JsonObject>();
+                    const auto duration = doc["duration"] | 2000;
+
+                    if (!ledmanager::ledManager)
+                    {
+                        ESP_LOGE(TAG, "mqtt_receive_handle: ledManager is not initialized");
+                        continue;
+                    }
+
+                    espcpputils::RecursiveLockHelper ledGuard{ledmanager::led_lock->handle};
+                    ledmanager::ledManager->notify(CRGB{color["r"] | uint8_t{255}, color["g"] | uint8_t{255}, color["b"] | uint8_t{255}},
+                                                   espchrono::milliseconds32{duration});
                 }
                 else
                 {
@@ -243,6 +278,40 @@ void publishStatus()
         return ESP_OK;
     });
 
+    // {mqttTopic}/{hostname}/perf/{stage}: {"p50":..,"p99":..,"max":..,"count":..} (us)
+    auto stages = std::make_unique<decltype(ledmanager::RenderStats::stages)>();
+
+    {
+        espcpputils::RecursiveLockHelper ledGuard{ledmanager::led_lock->handle};
+        *stages = ledmanager::renderStats().stages;
+    }
+
+    iterateEnum<RenderStage>::iterate([&](RenderStage stage, const char *name) {
+        const auto& histogram = (*stages)[static_cast<size_t>(stage)];
+
+        publishQueue.push(std::make_tuple(
+            std::format("{}/{}/perf/{}", configs.mqttTopic.value(), configs.hostname.value(), name),
+            std::format(R"({{"p50":{},"p99":{},"max":{},"count":{}}})", histogram.percentile(50), histogram.percentile(99), histogram.max(), histogram.count())
+        ));
+    });
+
+    // {mqttTopic}/{hostname}/tasks/{task}: {"exec":{"p50":..,"p95":..,"p99":..,"max":..},"late":{..}} (us)
+    if (configs.mqttTaskStats.value())
+    {
+        const auto summary = [](const Histogram& histogram) {
+            return std::format(R"({{"p50":{},"p95":{},"p99":{},"max":{}}})",
+                               histogram.percentile(50), histogram.percentile(95), histogram.percentile(99), histogram.max());
+        };
+
+        for (const auto& task : tasks)
+        {
+            publishQueue.push(std::make_tuple(
+                std::format("{}/{}/tasks/{}", configs.mqttTopic.value(), configs.hostname.value(), task.name()),
+                std::format(R"({{"exec":{},"late":{}}})", summary(task.executionTimes()), summary(task.lateness()))
+            ));
+        }
+    }
+
     lastMqttPublish = espchrono::millis_clock::now();
 }
 
@@ -452,6 +521,28 @@ void publishHomeassistantDiscovery()
                 payload));
     }
 
+    // {mqttTopic}/{hostname}/status/led/currentMa (estimated strip current)
+
+    {
+        doc.clear();
+        doc["name"] = "LED Current";
+        doc["state_topic"] = std::format("{}/{}/status/led/currentMa", configs.mqttTopic.value(), configs.hostname.value());
+        doc["availability_topic"] = std::format("{}/{}/online", configs.mqttTopic.value(), configs.hostname.value());
+        doc["unit_of_measurement"] = "mA";
+        doc["value_template"] = "{{ value_json }}";
+        doc["state_class"] = "measurement";
+        doc["device_class"] = "current";
+        doc["unique_id"] = std::format("{}_led_current", configs.hostname.value());
+        fillCommonStuff(doc);
+
+        std::string payload;
+        serializeJson(doc, payload);
+
+        publishQueue.push(std::make_tuple(
+                std::format("{}sensor/{}/led_current/config", configs.hassMqttTopic.value(), configs.hostname.value()),
+                payload));
+    }
+
     {
         doc.clear();
         doc["name"] = "Light";
@@ -584,8 +675,7 @@ void init(std::string_view url)
     mqttState = MqttState::NotStarted;
 
     {
-        const auto result = espcpputils::createTask(mqtt_handle_send, "mqttSend", 4096, nullptr, 5, nullptr,
-                                                    espcpputils::CoreAffinity::Both);
+        const auto result = taskplacement::createTask(mqtt_handle_send, "mqttSend", nullptr, nullptr);
         if (result != pdPASS)
         {
             auto msg = std::format("failed creating mqtt task {}", result);
@@ -595,8 +685,7 @@ void init(std::string_view url)
     }
 
     {
-        const auto result = espcpputils::createTask(mqtt_handle_receive, "mqttReceive", 4096, nullptr, 5, nullptr,
-                                                    espcpputils::CoreAffinity::Both);
+        const auto result = taskplacement::createTask(mqtt_handle_receive, "mqttReceive", nullptr, nullptr);
         if (result != pdPASS)
         {
             auto msg = std::format("failed creating mqtt task {}", result);
@@ -722,7 +811,7 @@ void update()
 
     if (configs.mqttEnabled.value() && mqttState == MqttState::NotStarted)
     {
-        if (const auto value = configs.mqttUrl.value(); value.empty())
+        if (const auto& value = configs.mqttUrl.value(); value.empty())
         {
             return;
         }
@@ -734,9 +823,12 @@ void update()
 
     if (mqttState != MqttState::NotStarted)
     {
-        if (const auto value = configs.mqttUrl.value(); !value.empty() && value != lastMqttUrl)
+        if (mqttUrlChanged.consume())
         {
-            init(value);
+            if (const auto& value = configs.mqttUrl.value(); !value.empty() && value != lastMqttUrl)
+            {
+                init(value);
+            }
         }
 
         if (mqttState == MqttState::Initialized)
@@ -0,0 +1,246 @@
+#include "realtime.h"
+
+constexpr const char * const TAG = "realtime";
+
+// system includes
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+
+// esp-idf includes
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <lwip/sockets.h>
+
+// 3rdparty lib includes
+#include <espchrono.h>
+#include <recursivelockhelper.h>
+
+// local includes
+#include "peripheral/ledmanager.h"
+#include "utils/logbuffer.h"
+#include "utils/renderconfig.h"
+#include "utils/taskplacement.h"
+
+using namespace std::chrono_literals;
+
+namespace realtime {
+
+namespace {
+
+struct Listener
+{
+    Protocol protocol;
+    uint16_t port;
+    int fd{-1};
+};
+
+// largest udp payload that fits an ethernet frame, DDP and WLED senders stay below it
+constexpr size_t MAX_PACKET_SIZE = 1472;
+
+std::array<Listener, 3> listeners{
+    Listener{ .protocol = Protocol::Ddp,  .port = DDP_PORT },
+    Listener{ .protocol = Protocol::E131, .port = E131_PORT },
+    Listener{ .protocol = Protocol::Wled, .port = WLED_PORT },
+};
+
+// everything below is guarded by led_lock, except pendingSince
+Stats realtimeStats;
+
+std::optional<espchrono::millis_clock::time_point> lastPacket;
+
+// unset while a WLED sender asked to stay in realtime mode until it stops
+std::optional<espchrono::milliseconds32> timeout;
+
+// last sequence number per DDP stream or E1.31 universe
+std::array<std::optional<uint8_t>, 8> lastSequence;
+
+// receive time of the oldest packet not shown yet, 0 if none
+std::atomic<int64_t> pendingSince{};
+
+void handlePacket(const Protocol protocol, std::string_view data)
+{
+    const auto receivedAt = esp_timer_get_time();
+
+    bool push{};
+
+    {
+        espcpputils::RecursiveLockHelper guard{ledmanager::led_lock->handle};
+
+        const auto& config = renderconfig::get();
+
+        if (!config.realtimeEnabled)
+            return;
+
+        auto& leds = ledmanager::mutableLeds();
+
+        // CRGB is three plain bytes, the packets are decoded in place
+        const auto result = decode(protocol, data, reinterpret_cast<uint8_t*>(leds.data()), leds.size(), config.realtimeUniverse);
+
+        ++realtimeStats.packets;
+
+        if (!result)
+        {
+            ++realtimeStats.invalid;
+            LOG_RATELIMITED(ESP_LOG_WARN, 10s, TAG, "dropped %.*s packet: %.*s", int(toString(protocol).size()), toString(protocol).data(),
+                            int(result.error().size()), result.error().data());
+            return;
+        }
+
+        if (realtimeStats.protocol != protocol)
+        {
+            realtimeStats.protocol = protocol;
+            lastSequence = {};
+            ESP_LOGI(TAG, "receiving %.*s", int(toString(protocol).size()), toString(protocol).data());
+        }
+
+        if (result->sequence)
+        {
+            auto& last = lastSequence[result->universe % lastSequence.size()];
+
+            if (last)
+                realtimeStats.lost += lostBetween(protocol, *last, *result->sequence);
+
+            last = result->sequence;
+        }
+
+        if (result->terminate)
+        {
+            lastPacket.reset();
+            ledmanager::requestFrame();
+            return;
+        }
+
+        lastPacket = espchrono::millis_clock::now();
+
+        if (!result->timeout)
+            timeout = espchrono::milliseconds32{config.realtimeTimeoutMs};
+        else if (*result->timeout >= WLED_TIMEOUT_FOREVER)
+            timeout.reset();
+        else
+            timeout = *result->timeout;
+
+        push = result->push;
+
+        if (push)
+            ++realtimeStats.frames;
+    }
+
+    if (push)
+    {
+        int64_t expected{};
+        pendingSince.compare_exchange_strong(expected, receivedAt);
+
+        ledmanager::requestFrame();
+    }
+}
+
+bool listen(Listener& listener)
+{
+    listener.fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (listener.fd < 0)
+        return false;
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(listener.port);
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    if (bind(listener.fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0)
+    {
+        close(listener.fd);
+        listener.fd = -1;
+        return false;
+    }
+
+    return true;
+}
+
+[[noreturn]] void udp_task(void*)
+{
+    static std::array<char, MAX_PACKET_SIZE> packet;
+
+    while (true)
+    {
+        fd_set readable;
+        FD_ZERO(&readable);
+
+        int maxFd{-1};
+        for (const auto& listener : listeners)
+        {
+            if (listener.fd < 0)
+                continue;
+
+            FD_SET(listener.fd, &readable);
+            maxFd = std::max(maxFd, listener.fd);
+        }
+
+        // sleeps until a packet arrives instead of polling every tick
+        if (const auto ready = select(maxFd + 1, &readable, nullptr, nullptr, nullptr); ready <= 0)
+        {
+            if (ready < 0)
+            {
+                LOG_RATELIMITED(ESP_LOG_ERROR, 10s, TAG, "select() failed: %d", errno);
+                vTaskDelay(pdMS_TO_TICKS(100));
+            }
+            continue;
+        }
+
+        for (const auto& listener : listeners)
+        {
+            if (listener.fd < 0 || !FD_ISSET(listener.fd, &readable))
+                continue;
+
+            while (true)
+            {
+                const auto size = recv(listener.fd, packet.data(), packet.size(), MSG_DONTWAIT);
+                if (size < 0)
+                    break;
+
+                handlePacket(listener.protocol, std::string_view{packet.data(), size_t(size)});
+            }
+        }
+    }
+}
+
+} // namespace
+
+void begin()
+{
+    for (auto& listener : listeners)
+    {
+        if (!listen(listener))
+        {
+            ESP_LOGE(TAG, "could not listen on %hu for %.*s", listener.port, int(toString(listener.protocol).size()), toString(listener.protocol).data());
+        }
+    }
+
+    if (const auto result = taskplacement::createTask(udp_task, "realtimeUdp", nullptr, nullptr); result != pdPASS)
+    {
+        ESP_LOGE(TAG, "failed creating udp task %d", result);
+    }
+}
+
+bool active()
+{
+    if (!lastPacket || !renderconfig::get().realtimeEnabled)
+        return false;
+
+    return !timeout || espchrono::ago(*lastPacket) < *timeout;
+}
+
+void frameShown()
+{
+    if (const auto since = pendingSince.exchange(0); since)
+        realtimeStats.latency.record(esp_timer_get_time() - since);
+}
+
+const Stats& stats()
+{
+    return realtimeStats;
+}
+
+} // namespace realtime
@@ -0,0 +1,38 @@
+#pragma once
+
+// system includes
+#include <cstdint>
+#include <optional>
+
+// local includes
+#include "communication/realtimeprotocol.h"
+#include "utils/histogram.h"
+
+// Realtime mode: DDP, E1.31 and WLED udp packets are decoded straight into the led back
+// buffer and the animations pause until no packet arrived for the configured timeout.
+namespace realtime {
+
+struct Stats
+{
+    uint32_t packets{};
+    uint32_t invalid{};
+    uint32_t lost{};
+    uint32_t frames{};
+    std::optional<Protocol> protocol{};
+    // from receiving the packet that completed a frame until the frame was sent out, in us
+    Histogram latency{};
+};
+
+// opens the udp ports and starts the receive task
+void begin();
+
+// true while packets keep the animations paused, take led_lock
+bool active();
+
+// called by the render task after a frame went out, take led_lock
+void frameShown();
+
+// take led_lock
+const Stats& stats();
+
+} // namespace realtime
@@ -0,0 +1,264 @@
+#include "realtimeprotocol.h"
+
+// system includes
+#include <algorithm>
+#include <cstring>
+#include <format>
+
+namespace realtime {
+
+namespace {
+
+uint16_t readU16(std::string_view data, size_t offset)
+{
+    return (uint8_t(data[offset]) << 8) | uint8_t(data[offset + 1]);
+}
+
+uint32_t readU32(std::string_view data, size_t offset)
+{
+    return (uint32_t{readU16(data, offset)} << 16) | readU16(data, offset + 2);
+}
+
+// copies bytes to a byte offset of the strip, returns the leds touched
+Frame writeBytes(std::string_view bytes, size_t byteOffset, uint8_t* leds, size_t ledCount)
+{
+    const size_t total = ledCount * 3;
+
+    Frame frame;
+    frame.firstLed = std::min(byteOffset / 3, ledCount);
+
+    if (byteOffset >= total)
+        return frame;
+
+    const auto length = std::min(bytes.size(), total - byteOffset);
+    std::memcpy(leds + byteOffset, bytes.data(), length);
+
+    frame.ledCount = (byteOffset + length + 2) / 3 - frame.firstLed;
+
+    return frame;
+}
+
+// http://www.3waylabs.com/ddp/
+std::expected<Frame, std::string> decodeDdp(std::string_view packet, uint8_t* leds, size_t ledCount)
+{
+    constexpr uint8_t flagPush = 0x01;
+    constexpr uint8_t flagQuery = 0x02;
+    constexpr uint8_t flagTimecode = 0x10;
+
+    if (packet.size() < 10)
+        return std::unexpected("DDP packet too short");
+
+    const uint8_t flags = packet[0];
+
+    if ((flags >> 6) != 1)
+        return std::unexpected(std::format("unsupported DDP version {}", flags >> 6));
+
+    if (flags & flagQuery)
+        return std::unexpected("DDP queries are not supported");
+
+    // undefined, rgb and rgb 8 bit per channel
+    if (const uint8_t type = packet[2]; type != 0x00 && type != 0x01 && type != 0x0b)
+        return std::unexpected(std::format("unsupported DDP data type {:#04x}", type));
+
+    // 0 is reserved but sent by some controllers, 1 is the default output
+    if (const uint8_t destination = packet[3]; destination > 1)
+        return std::unexpected(std::format("unsupported DDP destination {}", destination));
+
+    const size_t headerSize = flags & flagTimecode ? 14 : 10;
+    const uint32_t offset = readU32(packet, 4);
+    const uint16_t length = readU16(packet, 8);
+
+    if (packet.size() < headerSize + length)
+        return std::unexpected("DDP packet shorter than its length field");
+
+    auto frame = writeBytes(packet.substr(headerSize, length), offset, leds, ledCount);
+
+    if (const uint8_t sequence = packet[1] & 0x0f)
+        frame.sequence = sequence;
+
+    frame.push = flags & flagPush;
+
+    return frame;
+}
+
+// ANSI E1.31-2018, data packets only
+std::expected<Frame, std::string> decodeE131(std::string_view packet, uint8_t* leds, size_t ledCount, uint16_t firstUniverse)
+{
+    constexpr std::string_view acnPacketIdentifier{"ASC-E1.17\0\0\0", 12};
+    constexpr uint32_t vectorRootData = 0x00000004;
+    constexpr uint32_t vectorFramingData = 0x00000002;
+    constexpr uint8_t optionPreview = 0x80;
+    constexpr uint8_t optionTerminated = 0x40;
+    constexpr size_t dataOffset = 126;
+
+    if (packet.size() < dataOffset)
+        return std::unexpected("E1.31 packet too short");
+
+    if (readU16(packet, 0) != 0x0010 || packet.substr(4, acnPacketIdentifier.size()) != acnPacketIdentifier)
+        return std::unexpected("not an E1.31 packet");
+
+    if (readU32(packet, 18) != vectorRootData || readU32(packet, 40) != vectorFramingData)
+        return std::unexpected("unsupported E1.31 vector");
+
+    if (packet[117] != 0x02 || uint8_t(packet[118]) != 0xa1)
+        return std::unexpected("invalid E1.31 DMP layer");
+
+    const uint8_t options = packet[112];
+    const uint16_t universe = readU16(packet, 113);
+
+    Frame frame;
+    frame.sequence = uint8_t(packet[111]);
+    frame.universe = universe;
+
+    if (options & optionTerminated)
+    {
+        frame.terminate = true;
+        return frame;
+    }
+
+    if (options & optionPreview)
+        return std::unexpected("E1.31 preview data");
+
+    // property values include the start code, only plain dmx data carries pixels
+    const uint16_t propertyCount = readU16(packet, 123);
+    if (propertyCount < 1 || packet.size() < dataOffset - 1 + propertyCount)
+        return std::unexpected("E1.31 packet shorter than its property count");
+
+    if (packet[125] != 0)
+        return std::unexpected(std::format("unsupported E1.31 start code {}", uint8_t(packet[125])));
+
+    if (universe < firstUniverse)
+        return std::unexpected(std::format("E1.31 universe {} not mapped", universe));
+
+    const size_t index = universe - firstUniverse;
+    const size_t channels = std::min<size_t>(propertyCount - 1, E131_LEDS_PER_UNIVERSE * 3);
+
+    auto written = writeBytes(packet.substr(dataOffset, channels), index * E131_LEDS_PER_UNIVERSE * 3, leds, ledCount);
+    written.sequence = frame.sequence;
+    written.universe = universe;
+
+    // the universe holding the last led completes the frame
+    written.push = ledCount && index == (ledCount - 1) / E131_LEDS_PER_UNIVERSE;
+
+    return written;
+}
+
+// https://kno.wled.ge/interfaces/udp-realtime/
+std::expected<Frame, std::string> decodeWled(std::string_view packet, uint8_t* leds, size_t ledCount)
+{
+    enum : uint8_t { Warls = 1, Drgb = 2, Drgbw = 3, Dnrgb = 4 };
+
+    if (packet.size() < 2)
+        return std::unexpected("WLED packet too short");
+
+    const uint8_t protocol = packet[0];
+    const std::chrono::seconds timeout{uint8_t(packet[1])};
+    const auto data = packet.substr(2);
+
+    Frame frame;
+
+    switch (protocol)
+    {
+    case Warls:
+    {
+        size_t first = ledCount;
+        size_t last = 0;
+
+        for (size_t i = 0; i + 4 <= data.size(); i += 4)
+        {
+            const uint8_t index = data[i];
+            if (index >= ledCount)
+                continue;
+
+            std::memcpy(leds + index * 3, data.data() + i + 1, 3);
+            first = std::min<size_t>(first, index);
+            last = std::max<size_t>(last, index);
+        }
+
+        if (first < ledCount)
+        {
+            frame.firstLed = first;
+            frame.ledCount = last - first + 1;
+        }
+        break;
+    }
+    case Drgb:
+        frame = writeBytes(data, 0, leds, ledCount);
+        break;
+    case Drgbw:
+    {
+        const auto count = std::min(data.size() / 4, ledCount);
+
+        for (size_t i = 0; i < count; ++i)
+            std::memcpy(leds + i * 3, data.data() + i * 4, 3);
+
+        frame.ledCount = count;
+        break;
+    }
+    case Dnrgb:
+        if (data.size() < 2)
+            return std::unexpected("DNRGB packet too short");
+
+        frame = writeBytes(data.substr(2), size_t{readU16(data, 0)} * 3, leds, ledCount);
+        break;
+    default:
+        return std::unexpected(std::format("unsupported WLED protocol {}", protocol));
+    }
+
+    frame.push = true;
+    frame.timeout = timeout;
+
+    return frame;
+}
+
+} // namespace
+
+std::string_view toString(const Protocol protocol)
+{
+    switch (protocol)
+    {
+    case Protocol::Ddp: return "DDP";
+    case Protocol::E131: return "E1.31";
+    case Protocol::Wled: return "WLED";
+    }
+
+    return "unknown";
+}
+
+std::expected<Frame, std::string> decode(const Protocol protocol, std::string_view packet, uint8_t* leds, const size_t ledCount, const uint16_t firstUniverse)
+{
+    switch (protocol)
+    {
+    case Protocol::Ddp: return decodeDdp(packet, leds, ledCount);
+    case Protocol::E131: return decodeE131(packet, leds, ledCount, firstUniverse);
+    case Protocol::Wled: return decodeWled(packet, leds, ledCount);
+    }
+
+    return std::unexpected("unknown protocol");
+}
+
+uint8_t lostBetween(const Protocol protocol, const uint8_t last, const uint8_t current)
+{
+    switch (protocol)
+    {
+    case Protocol::Ddp:
+        // 0 means the sender does not count, a repeated packet lost nothing
+        if (!last || !current || current == last)
+            return 0;
+
+        // counts 1..15 and wraps to 1
+        return (current + 15 - last - 1) % 15;
+    case Protocol::E131:
+    {
+        // E1.31 6.7.2, a step back of up to 20 is a late packet, not a loss
+        const auto diff = static_cast<int8_t>(current - last);
+        return diff > 0 ? diff - 1 : 0;
+    }
+    case Protocol::Wled:
+        break;
+    }
+
+    return 0;
+}
+
+} // namespace realtime
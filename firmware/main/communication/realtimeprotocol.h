@@ -0,0 +1,58 @@
+#pragma once
+
+// system includes
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Decoders for realtime pixel packets. Only depends on the standard library so it can be
+// built and fed on a host, tools/realtime-send produces matching packets.
+namespace realtime {
+
+enum class Protocol : uint8_t
+{
+    Ddp,
+    E131,
+    Wled,
+};
+
+constexpr uint16_t DDP_PORT = 4048;
+constexpr uint16_t E131_PORT = 5568;
+constexpr uint16_t WLED_PORT = 21324;
+
+// dmx channels of one E1.31 universe used for pixels
+constexpr size_t E131_LEDS_PER_UNIVERSE = 170;
+
+// WLED timeout byte that keeps realtime mode until the sender stops it
+constexpr std::chrono::seconds WLED_TIMEOUT_FOREVER{255};
+
+struct Frame
+{
+    // range of leds the packet wrote to, clipped to the strip
+    size_t firstLed{};
+    size_t ledCount{};
+    // DDP: 1..15, E1.31: per universe, unset if the sender does not count
+    std::optional<uint8_t> sequence{};
+    uint16_t universe{};
+    // the frame is complete and should be shown now
+    bool push{};
+    // the sender ended the stream
+    bool terminate{};
+    // WLED: how long to stay in realtime mode, overrides the configured timeout
+    std::optional<std::chrono::seconds> timeout{};
+};
+
+std::string_view toString(Protocol protocol);
+
+// Writes the pixels of the packet into leds (ledCount rgb triplets), pixels past the end
+// are dropped. firstUniverse maps E1.31 universes to the strip, 170 leds per universe.
+std::expected<Frame, std::string> decode(Protocol protocol, std::string_view packet, uint8_t* leds, size_t ledCount, uint16_t firstUniverse);
+
+// packets missing between two sequence numbers of the protocol
+uint8_t lostBetween(Protocol protocol, uint8_t last, uint8_t current);
+
+} // namespace realtime
@@ -12,6 +12,8 @@ constexpr const char * const TAG = "webserver";
 // local includes
 #include "webserver_api.h"
 #include "webserver_frontend.h"
+#include "webserver_ws.h"
+#include "utils/taskplacement.h"
 
 namespace webserver {
 
@@ -19,10 +21,13 @@ httpd_handle_t httpdHandle;
 
 void begin()
 {
+    const auto& placement = taskplacement::get("httpd");
+
     httpd_config_t httpdConfig = HTTPD_DEFAULT_CONFIG();
-    httpdConfig.core_id = 1;
+    httpdConfig.core_id = taskplacement::coreId(placement.core);
+    httpdConfig.task_priority = placement.priority;
     httpdConfig.max_uri_handlers = 64;
-    httpdConfig.stack_size = 8192;
+    httpdConfig.stack_size = placement.stackSize;
 
     if (const auto result = httpd_start(&httpdHandle, &httpdConfig); result != ESP_OK)
     {
@@ -31,7 +36,13 @@ void begin()
     }
 
     webserver_api_setup(httpdHandle);
+    webserver_ws_setup(httpdHandle);
     webserver_frontend_setup(httpdHandle);
 }
 
+void update()
+{
+    webserver_ws_update();
+}
+
 } // namespace webserver
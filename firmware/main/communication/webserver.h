@@ -13,4 +13,6 @@ extern httpd_handle_t httpdHandle;
 
 void begin();
 
+void update();
+
 } // namespace webserver
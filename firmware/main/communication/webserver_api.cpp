@@ -3,16 +3,24 @@
 constexpr const char * const TAG = "webserver_api";
 
 // system includes
+#include <array>
+#include <cstring>
 #include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 // esp-idf includes
 #include <esp_app_desc.h>
 #include <esp_http_server.h>
 #include <esp_log.h>
+#include <esp_random.h>
 
 // 3rdparty lib includes
 #include <esphttpdutils.h>
 #include <makearray.h>
+#include <numberparsing.h>
 #include <recursivelockhelper.h>
 
 // local includes
@@ -24,6 +32,8 @@ constexpr const char * const TAG = "webserver_api";
 #include "peripheral/ledhelpers/ledanimation.h"
 #include "peripheral/ledmanager.h"
 #include "utils/global_lock.h"
+#include "utils/logbuffer.h"
+#include "utils/taskplacement.h"
 #include "utils/tasks.h"
 
 using namespace std::chrono_literals;
@@ -80,12 +90,19 @@ esp_err_t cors_handler(httpd_req_t* req)
         return res;
     }
 
+    if (const auto res = httpd_resp_set_hdr(req, "Access-Control-Expose-Headers", "X-Frame, X-Frame-Encoding, X-Log-Next");
+            res != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to set Access-Control-Expose-Headers header: %s", esp_err_to_name(res));
+        return res;
+    }
+
     return ESP_OK;
 }
 
 esp_err_t api_get_config_handler(httpd_req_t* req)
 {
-    ESP_LOGI(TAG, "GET /api/config");
+    ESP_LOGD(TAG, "GET /api/config");
 
     espcpputils::RecursiveLockHelper lockHelper{global::global_lock->handle};
 
@@ -132,7 +149,7 @@ esp_err_t api_get_config_handler(httpd_req_t* req)
 
         if (config->isLastKey)
         {
-            ESP_LOGI(TAG, "Last key reached");
+            ESP_LOGD(TAG, "Last key reached");
             break;
         }
     }
@@ -198,6 +215,7 @@ esp_err_t api_set_via_get_handler(httpd_req_t* req)
     }
 
     mqtt::force_publish_status();
+    ledmanager::requestFrame();
 
     return ESP_OK;
 }
@@ -270,6 +288,8 @@ esp_err_t api_set_via_post_handler(httpd_req_t* req)
 
     if (const auto result = setConfigFromJsonViaBody(body); result && result->success)
     {
+        ledmanager::requestFrame();
+
         if (const auto res = esphttpdutils::webserver_resp_send(req, esphttpdutils::ResponseStatus::Ok, "application/json", result->result.value()); res != ESP_OK)
         {
             ESP_LOGE(TAG, "Failed to send response: %s", esp_err_to_name(res));
@@ -298,8 +318,6 @@ esp_err_t api_get_leds_handler(httpd_req_t* req)
 {
     ESP_LOGD(TAG, "GET /api/leds");
 
-    espcpputils::RecursiveLockHelper lockHelper{global::global_lock->handle};
-
     if (const auto res = cors_handler(req); res != ESP_OK)
         return res;
 
@@ -309,7 +327,13 @@ esp_err_t api_get_leds_handler(httpd_req_t* req)
         return res;
     }
 
-    const auto& leds = ledmanager::getLeds();
+    // sending takes long, do not keep the render task waiting
+    ledmanager::LedArray leds;
+
+    {
+        espcpputils::RecursiveLockHelper ledLockHelper{ledmanager::led_lock->handle};
+        leds = ledmanager::getLeds();
+    }
 
     if (const auto res = httpd_resp_send_chunk(req, "[", 1); res != ESP_OK)
     {
@@ -343,9 +367,296 @@ esp_err_t api_get_leds_handler(httpd_req_t* req)
     return ESP_OK;
 }
 
+// differs on every boot so preview frame counters from before a reboot are never mistaken for ours
+const std::string& bootToken()
+{
+    static const auto token = std::format("{:08x}", esp_random());
+    return token;
+}
+
+// Raw rgb bytes of the back buffer. X-Frame is <boot>-<frame>, with ?since=<X-Frame of an earlier
+// response> only the leds changed after that frame are sent, as runs of start (uint16 le),
+// count (uint16 le) and count * rgb. X-Frame-Encoding tells which of the two the body is.
+esp_err_t api_get_leds_bin_handler(httpd_req_t* req)
+{
+    if (const auto res = cors_handler(req); res != ESP_OK)
+        return res;
+
+    std::optional<uint32_t> since;
+
+    if (auto result = esphttpdutils::webserver_get_query(req))
+    {
+        char value[24];
+        if (httpd_query_key_value(result->data(), "since", value, sizeof(value)) == ESP_OK)
+        {
+            // tokens from another boot or without one get a full frame
+            const std::string_view token{value};
+            if (const auto separator = token.find('-'); separator != std::string_view::npos &&
+                                                        token.substr(0, separator) == bootToken())
+                since = cpputils::fromString<uint32_t>(token.substr(separator + 1));
+        }
+    }
+
+    std::vector<uint8_t> body;
+    uint32_t frame;
+
+    {
+        espcpputils::RecursiveLockHelper ledLockHelper{ledmanager::led_lock->handle};
+
+        const auto& leds = ledmanager::getLeds();
+        const auto& changedFrames = ledmanager::ledChangedFrames();
+        frame = ledmanager::previewFrame();
+
+        // a frame we have not rendered yet (stale client or wrapped counter) gets a keyframe too
+        if (since && *since > frame)
+            since.reset();
+
+        if (!since)
+        {
+            body.resize(leds.size() * 3);
+            std::memcpy(body.data(), leds.data(), body.size());
+        }
+        else
+        {
+            body.reserve(64);
+
+            for (size_t i = 0; i < leds.size();)
+            {
+                if (changedFrames[i] <= *since)
+                {
+                    ++i;
+                    continue;
+                }
+
+                size_t end = i + 1;
+                while (end < leds.size() && changedFrames[end] > *since)
+                    ++end;
+
+                const uint16_t count = end - i;
+                body.insert(body.end(), { uint8_t(i), uint8_t(i >> 8), uint8_t(count), uint8_t(count >> 8) });
+
+                const auto rgb = reinterpret_cast<const uint8_t*>(&leds[i]);
+                body.insert(body.end(), rgb, rgb + count * 3);
+
+                i = end;
+            }
+        }
+    }
+
+    if (const auto res = httpd_resp_set_type(req, "application/octet-stream"); res != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to set content type: %s", esp_err_to_name(res));
+        return res;
+    }
+
+    const auto frameStr = std::format("{}-{}", bootToken(), frame);
+    if (const auto res = httpd_resp_set_hdr(req, "X-Frame", frameStr.c_str()); res != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to set header: %s", esp_err_to_name(res));
+        return res;
+    }
+
+    if (const auto res = httpd_resp_set_hdr(req, "X-Frame-Encoding", since ? "rle" : "raw"); res != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to set header: %s", esp_err_to_name(res));
+        return res;
+    }
+
+    if (const auto res = httpd_resp_send(req, reinterpret_cast<const char*>(body.data()), body.size()); res != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to send response: %s", esp_err_to_name(res));
+        return res;
+    }
+
+    return ESP_OK;
+}
+
+// little endian dump of the render stage histograms for tools that want the raw buckets
+struct PerfBinaryHeader
+{
+    char magic[4]{'P', 'E', 'R', 'F'};
+    uint8_t version{1};
+    uint8_t stageCount{RenderStageCount};
+    uint8_t bucketCount{Histogram::BUCKET_COUNT};
+    uint8_t reserved{};
+    uint32_t frames{};
+    // followed by bucketCount lower bounds as uint32, then per stage
+    // count (uint32), max (uint32), sum (uint64) and bucketCount counts (uint32)
+};
+static_assert(sizeof(PerfBinaryHeader) == 12);
+
+esp_err_t api_get_perf_handler(httpd_req_t* req)
+{
+    ESP_LOGD(TAG, "GET /api/perf");
+
+    if (const auto res = cors_handler(req); res != ESP_OK)
+        return res;
+
+    bool binary{};
+
+    if (auto result = esphttpdutils::webserver_get_query(req))
+    {
+        char format[8];
+        binary = httpd_query_key_value(result->data(), "format", format, sizeof(format)) == ESP_OK && std::strcmp(format, "bin") == 0;
+    }
+
+    // copy the histograms so the render task is not blocked while sending
+    auto stages = std::make_unique<decltype(ledmanager::RenderStats::stages)>();
+    uint32_t frames;
+
+    {
+        espcpputils::RecursiveLockHelper ledLockHelper{ledmanager::led_lock->handle};
+        const auto& stats = ledmanager::renderStats();
+        *stages = stats.stages;
+        frames = stats.frames;
+    }
+
+    const auto sendChunk = [req](const void* data, size_t size) {
+        const auto res = httpd_resp_send_chunk(req, static_cast<const char*>(data), size);
+        if (res != ESP_OK)
+            ESP_LOGE(TAG, "Failed to send response: %s", esp_err_to_name(res));
+        return res;
+    };
+
+    if (binary)
+    {
+        if (const auto res = httpd_resp_set_type(req, "application/octet-stream"); res != ESP_OK)
+        {
+            ESP_LOGE(TAG, "Failed to set content type: %s", esp_err_to_name(res));
+            return res;
+        }
+
+        const PerfBinaryHeader header{ .frames = frames };
+        if (const auto res = sendChunk(&header, sizeof(header)); res != ESP_OK)
+            return res;
+
+        std::array<uint32_t, Histogram::BUCKET_COUNT> bounds;
+        for (size_t i = 0; i < bounds.size(); ++i)
+            bounds[i] = Histogram::bucketLowerBound(i);
+
+        if (const auto res = sendChunk(bounds.data(), sizeof(bounds)); res != ESP_OK)
+            return res;
+
+        for (const auto& stage : *stages)
+        {
+            struct __attribute__((packed)) {
+                uint32_t count;
+                uint32_t max;
+                uint64_t sum;
+            } summary{ stage.count(), stage.max(), stage.sum() };
+
+            if (const auto res = sendChunk(&summary, sizeof(summary)); res != ESP_OK)
+                return res;
+
+            if (const auto res = sendChunk(stage.buckets().data(), sizeof(stage.buckets())); res != ESP_OK)
+                return res;
+        }
+
+        return httpd_resp_send_chunk(req, nullptr, 0);
+    }
+
+    if (const auto res = httpd_resp_set_type(req, "application/json"); res != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to set content type: %s", esp_err_to_name(res));
+        return res;
+    }
+
+    std::string json = std::format(R"({{"success":true,"unit":"us","frames":{},"bucketBounds":[)", frames);
+    for (size_t i = 0; i < Histogram::BUCKET_COUNT; ++i)
+        json += std::format("{}{}", i ? "," : "", Histogram::bucketLowerBound(i));
+    json += R"(],"stages":{)";
+
+    if (const auto res = sendChunk(json.data(), json.size()); res != ESP_OK)
+        return res;
+
+    esp_err_t result{ESP_OK};
+
+    iterateEnum<RenderStage>::iterate([&](RenderStage stage, const char* name) {
+        if (result != ESP_OK)
+            return;
+
+        const auto& histogram = (*stages)[static_cast<size_t>(stage)];
+
+        json = std::format(R"({}"{}":{{"count":{},"max":{},"avg":{},"p50":{},"p90":{},"p99":{},"buckets":[)",
+                           stage == RenderStage{} ? "" : ",", name, histogram.count(), histogram.max(), histogram.average(),
+                           histogram.percentile(50), histogram.percentile(90), histogram.percentile(99));
+        for (size_t i = 0; i < Histogram::BUCKET_COUNT; ++i)
+            json += std::format("{}{}", i ? "," : "", histogram.buckets()[i]);
+        json += "]}";
+
+        result = sendChunk(json.data(), json.size());
+    });
+
+    if (result != ESP_OK)
+        return result;
+
+    if (const auto res = sendChunk("}}", 2); res != ESP_OK)
+        return res;
+
+    return httpd_resp_send_chunk(req, nullptr, 0);
+}
+
+// plain text tail of the log ring, ?since= takes the X-Log-Next value of the previous response
+esp_err_t api_get_logs_handler(httpd_req_t* req)
+{
+    if (const auto res = cors_handler(req); res != ESP_OK)
+        return res;
+
+    const auto end = logbuffer::head();
+    auto sequence = logbuffer::tail();
+
+    if (auto result = esphttpdutils::webserver_get_query(req))
+    {
+        char since[12];
+        if (httpd_query_key_value(result->data(), "since", since, sizeof(since)) == ESP_OK)
+        {
+            if (const auto parsed = cpputils::fromString<uint32_t>(since); parsed && *parsed - sequence <= end - sequence)
+                sequence = *parsed;
+        }
+    }
+
+    if (const auto res = httpd_resp_set_type(req, "text/plain"); res != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to set content type: %s", esp_err_to_name(res));
+        return res;
+    }
+
+    // has to stay alive until the headers are sent with the first chunk
+    const auto next = std::to_string(end);
+    if (const auto res = httpd_resp_set_hdr(req, "X-Log-Next", next.c_str()); res != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to set header: %s", esp_err_to_name(res));
+        return res;
+    }
+
+    char line[logbuffer::LINE_LENGTH];
+
+    for (; sequence != end; ++sequence)
+    {
+        // overwritten or still being written
+        const auto length = logbuffer::read(sequence, line);
+        if (!length)
+            continue;
+
+        if (const auto res = httpd_resp_send_chunk(req, line, *length); res != ESP_OK)
+        {
+            ESP_LOGE(TAG, "Failed to send response: %s", esp_err_to_name(res));
+            return res;
+        }
+    }
+
+    if (const auto res = httpd_resp_send_chunk(req, nullptr, 0); res != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to send response: %s", esp_err_to_name(res));
+        return res;
+    }
+
+    return ESP_OK;
+}
+
 esp_err_t api_get_status_handler(httpd_req_t* req)
 {
-    ESP_LOGI(TAG, "GET /api/status");
+    ESP_LOGD(TAG, "GET /api/status");
     espcpputils::RecursiveLockHelper lockHelper{global::global_lock->handle};
 
     if (const auto res = cors_handler(req); res != ESP_OK)
@@ -373,46 +684,63 @@ esp_err_t api_get_status_handler(httpd_req_t* req)
 
 esp_err_t api_get_tasks_handler(httpd_req_t* req)
 {
-    ESP_LOGI(TAG, "GET /api/tasks");
+    ESP_LOGD(TAG, "GET /api/tasks");
 
     espcpputils::RecursiveLockHelper lockHelper{global::global_lock->handle};
 
     if (const auto res = cors_handler(req); res != ESP_OK)
         return res;
 
-    auto guard = getApiJson();
-    auto& doc = *guard;
-
-    doc.clear();
+    // two histogram summaries per task do not fit the api document, format by hand
+    const auto summary = [](const Histogram& histogram) {
+        return std::format(R"({{"count":{},"p50":{},"p95":{},"p99":{},"max":{}}})",
+                           histogram.count(), histogram.percentile(50), histogram.percentile(95), histogram.percentile(99), histogram.max());
+    };
 
-    doc["success"] = true;
+    std::string json{R"({"success":true,"tasks":[)"};
 
-    doc.set(JsonArray{}); // create empty array
+    bool first{true};
 
-    for (auto& task : tasks)
+    for (const auto& task : tasks)
     {
-        auto taskObj = doc.createNestedObject();
-
-        taskObj["name"] = task.name();
-        taskObj["count"] = task.callCount();
-        taskObj["last"] = std::chrono::floor<std::chrono::milliseconds>(task.lastElapsed()).count();
-        taskObj["avg"] = std::chrono::floor<std::chrono::milliseconds>(task.averageElapsed()).count();
-        taskObj["max"] = std::chrono::floor<std::chrono::milliseconds>(task.maxElapsed()).count();
+        // count, last, avg and max cover the last second in ms, exec and late everything since boot in us
+        json += std::format(R"({}{{"name":"{}","ownTask":{},"interval":{},"count":{},"last":{},"avg":{},"max":{},"exec":{},"late":{}}})",
+                            std::exchange(first, false) ? "" : ",",
+                            task.name(),
+                            task.taskHandle() != nullptr,
+                            task.interval().count(),
+                            task.callCount(),
+                            std::chrono::floor<std::chrono::milliseconds>(task.lastElapsed()).count(),
+                            std::chrono::floor<std::chrono::milliseconds>(task.averageElapsed()).count(),
+                            std::chrono::floor<std::chrono::milliseconds>(task.maxElapsed()).count(),
+                            summary(task.executionTimes()),
+                            summary(task.lateness()));
     }
 
-    if (doc.overflowed())
+    json += R"(],"threads":[)";
+
+    first = true;
+
+    // configured placement next to what the kernel reports, a thread missing here failed to start
+    for (const auto& placement : taskplacement::all())
     {
-        if (const auto res = esphttpdutils::webserver_resp_send(req, esphttpdutils::ResponseStatus::InternalServerError, "application/json", R"({"success":false,"message":"Failed to serialize JSON"})"); res != ESP_OK)
-        {
-            ESP_LOGE(TAG, "Failed to send response: %s", esp_err_to_name(res));
-            return res;
-        }
-        return ESP_FAIL;
-    }
+        if (!placement.ownTask)
+            continue;
 
-    std::string json;
+        json += std::format(R"({}{{"name":"{}","core":"{}","priority":{},"stack":{})",
+                            std::exchange(first, false) ? "" : ",",
+                            placement.name,
+                            taskplacement::toString(placement.core),
+                            placement.priority,
+                            placement.stackSize);
 
-    serializeJson(doc, json);
+        if (const auto handle = xTaskGetHandle(placement.name))
+            json += std::format(R"(,"running":true,"currentPriority":{},"stackFree":{}}})", uxTaskPriorityGet(handle), uxTaskGetStackHighWaterMark(handle));
+        else
+            json += R"(,"running":false})";
+    }
+
+    json += "]}";
 
     if (const auto res = esphttpdutils::webserver_resp_send(req, esphttpdutils::ResponseStatus::Ok, "application/json", json); res != ESP_OK)
     {
@@ -570,6 +898,9 @@ esp_err_t api_trigger_ota_handler(httpd_req_t* req)
         return ESP_FAIL;
     }
 
+    // start the download right away instead of with the next ota tick
+    sched_wakeup("ota");
+
     // set redirect header to /
     if (const auto res = httpd_resp_set_hdr(req, "Location", "/");
         res != ESP_OK)
@@ -646,6 +977,9 @@ auto get_handlers()
         httpd_uri_t{ .uri = "/api/v1/set",        .method = HTTP_GET,  .handler = api_set_via_get_handler,    .user_ctx = nullptr },
         httpd_uri_t{ .uri = "/api/v1/set",        .method = HTTP_POST, .handler = api_set_via_post_handler,   .user_ctx = nullptr },
         httpd_uri_t{ .uri = "/api/v1/leds",       .method = HTTP_GET,  .handler = api_get_leds_handler,       .user_ctx = nullptr },
+        httpd_uri_t{ .uri = "/api/v1/leds.bin",   .method = HTTP_GET,  .handler = api_get_leds_bin_handler,   .user_ctx = nullptr },
+        httpd_uri_t{ .uri = "/api/v1/perf",       .method = HTTP_GET,  .handler = api_get_perf_handler,       .user_ctx = nullptr },
+        httpd_uri_t{ .uri = "/api/v1/logs",       .method = HTTP_GET,  .handler = api_get_logs_handler,       .user_ctx = nullptr },
         httpd_uri_t{ .uri = "/api/v1/tasks",      .method = HTTP_GET,  .handler = api_get_tasks_handler,      .user_ctx = nullptr },
         httpd_uri_t{ .uri = "/api/v1/ota",        .method = HTTP_GET,  .handler = api_get_ota_status_handler, .user_ctx = nullptr },
         httpd_uri_t{ .uri = "/api/v1/triggerOta", .method = HTTP_GET,  .handler = api_trigger_ota_handler,    .user_ctx = nullptr },
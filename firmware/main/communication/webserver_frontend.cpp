@@ -14,6 +14,9 @@ constexpr const char * const TAG = "webserver_frontend";
 
 // local includes
 #include "utils/config.h"
+#include "utils/logbuffer.h"
+
+using namespace std::chrono_literals;
 
 namespace webserver {
 
@@ -21,7 +24,7 @@ esp_err_t captive_portal_handler(httpd_req_t *req)
 {
     const auto handler = reinterpret_cast<esp_err_t(*)(httpd_req_t*)>(req->user_ctx);
 
-    ESP_LOGI(TAG, "captive_portal_handler()");
+    ESP_LOGD(TAG, "captive_portal_handler()");
 
     char host[32];
 
@@ -31,14 +34,14 @@ esp_err_t captive_portal_handler(httpd_req_t *req)
         return ESP_FAIL;
     }
 
-    ESP_LOGI(TAG, "Host: %s", host);
+    ESP_LOGD(TAG, "Host: %s", host);
 
     // if host is not the same as the AP IP, serve the captive portal
     if (host != toString(configs.wifiApIp.value()))
     {
         // redirect to the captive portal
         const auto redirectUrl = std::format("http://{}/", toString(configs.wifiApIp.value()));
-        ESP_LOGI(TAG, "Redirecting to %s", redirectUrl.c_str());
+        LOG_RATELIMITED(ESP_LOG_INFO, 10s, TAG, "Redirecting %s to %s", host, redirectUrl.c_str());
         httpd_resp_set_hdr(req, "Location", redirectUrl.c_str());
         httpd_resp_set_status(req, "302 Found");
         httpd_resp_send(req, nullptr, 0);
@@ -51,10 +54,10 @@ esp_err_t captive_portal_handler(httpd_req_t *req)
 
 esp_err_t handle_not_found(httpd_req_t* req, httpd_err_code_t error)
 {
-    ESP_LOGW(TAG, "handle_not_found(): %d", error);
+    LOG_RATELIMITED(ESP_LOG_WARN, 10s, TAG, "handle_not_found(): %d", error);
     // redirect to /
     const auto redirectUrl = std::format("http://{}/", toString(configs.wifiApIp.value()));
-    ESP_LOGI(TAG, "Redirecting to %s", redirectUrl.c_str());
+    ESP_LOGD(TAG, "Redirecting to %s", redirectUrl.c_str());
     if (const auto res = httpd_resp_set_hdr(req, "Location", redirectUrl.c_str()); res != ESP_OK)
     {
         ESP_LOGE(TAG, "httpd_resp_set_hdr(): %s", esp_err_to_name(res));
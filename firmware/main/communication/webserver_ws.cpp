@@ -0,0 +1,420 @@
+#include "webserver_ws.h"
+
+constexpr const char * const TAG = "webserver_ws";
+
+// system includes
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <format>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// esp-idf includes
+#include <esp_log.h>
+
+// 3rdparty lib includes
+#include <ArduinoJson.h>
+#include <delayedconstruction.h>
+#include <espchrono.h>
+#include <recursivelockhelper.h>
+#include <wrappers/recursive_mutex_semaphore.h>
+
+// local includes
+#include "communication/helper/status.h"
+#include "communication/helper/toJson.h"
+#include "peripheral/ledmanager.h"
+#include "utils/config.h"
+#include "utils/configsubscription.h"
+#include "utils/global_lock.h"
+#include "utils/typehelpers.h"
+
+using namespace std::chrono_literals;
+
+namespace webserver {
+
+namespace {
+
+constexpr espchrono::milliseconds32 statusInterval{1000};
+constexpr espchrono::milliseconds32 minLedInterval{50};
+
+struct Client
+{
+    int fd{-1};
+    // 0 while the client does not want led frames
+    espchrono::milliseconds32 ledInterval{};
+    espchrono::millis_clock::time_point lastLeds{};
+    std::optional<uint32_t> ledFrame{};
+};
+
+httpd_handle_t serverHandle{nullptr};
+
+// written by the httpd task, read by webserver_ws_update()
+std::array<Client, 4> clients;
+cpputils::DelayedConstruction<espcpputils::recursive_mutex_semaphore> clientsLock;
+
+// serialized value per key as last pushed, a change is anything that serializes differently
+std::map<std::string, std::string> lastStatus;
+std::map<const char*, std::string> lastConfig;
+
+// fills lastConfig on the first update
+configutils::ConfigSubscription configChanged{[](const ConfigWrapperInterface&) { return true; }};
+
+espchrono::millis_clock::time_point lastStatusPush{};
+
+// a new client gets the complete status with the next push
+std::atomic<bool> clientConnected{};
+
+// one encoded payload shared by all clients it is queued for
+struct Payload
+{
+    std::string data;
+    httpd_ws_type_t type;
+    std::atomic<uint8_t> pending{};
+};
+
+void sendDone(esp_err_t err, int fd, void* arg)
+{
+    if (err != ESP_OK)
+        ESP_LOGW(TAG, "sending to %d failed: %s", fd, esp_err_to_name(err));
+
+    auto* payload = static_cast<Payload*>(arg);
+    if (payload->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete payload;
+}
+
+template<typename Fds>
+void broadcast(const Fds& fds, std::string&& data, const httpd_ws_type_t type)
+{
+    if (fds.empty())
+        return;
+
+    auto* payload = new Payload{ .data = std::move(data), .type = type };
+
+    // keeps the payload alive until all sends are queued
+    payload->pending.store(fds.size() + 1, std::memory_order_relaxed);
+
+    for (const auto fd : fds)
+    {
+        httpd_ws_frame_t frame{
+            .final = true,
+            .fragmented = false,
+            .type = payload->type,
+            .payload = reinterpret_cast<uint8_t*>(payload->data.data()),
+            .len = payload->data.size(),
+        };
+
+        if (const auto res = httpd_ws_send_data_async(serverHandle, fd, &frame, sendDone, payload); res != ESP_OK)
+            sendDone(res, fd, payload);
+    }
+
+    sendDone(ESP_OK, -1, payload);
+}
+
+void handleMessage(const int fd, std::string_view message)
+{
+    StaticJsonDocument<64> doc;
+
+    if (const auto error = deserializeJson(doc, message.data(), message.size()); error)
+    {
+        ESP_LOGW(TAG, "invalid message from %d: %s", fd, error.c_str());
+        return;
+    }
+
+    if (!doc.containsKey("leds"))
+        return;
+
+    const auto interval = doc["leds"].as<uint32_t>();
+
+    espcpputils::RecursiveLockHelper guard{clientsLock->handle};
+
+    for (auto& client : clients)
+    {
+        if (client.fd != fd)
+            continue;
+
+        client.ledInterval = interval ? std::max<espchrono::milliseconds32>(espchrono::milliseconds32{interval}, minLedInterval) : espchrono::milliseconds32{};
+        client.ledFrame.reset();
+    }
+}
+
+esp_err_t ws_handler(httpd_req_t* req)
+{
+    const auto fd = httpd_req_to_sockfd(req);
+
+    // the handshake
+    if (req->method == HTTP_GET)
+    {
+        espcpputils::RecursiveLockHelper guard{clientsLock->handle};
+
+        const auto free = std::find_if(std::begin(clients), std::end(clients), [](const Client& client) {
+            return client.fd < 0 || httpd_ws_get_fd_info(serverHandle, client.fd) != HTTPD_WS_CLIENT_WEBSOCKET;
+        });
+
+        if (free == std::end(clients))
+        {
+            ESP_LOGW(TAG, "no slot left for %d", fd);
+            return ESP_FAIL;
+        }
+
+        *free = Client{ .fd = fd };
+        clientConnected = true;
+
+        ESP_LOGI(TAG, "client %d connected", fd);
+        return ESP_OK;
+    }
+
+    httpd_ws_frame_t frame{};
+
+    if (const auto res = httpd_ws_recv_frame(req, &frame, 0); res != ESP_OK)
+    {
+        ESP_LOGE(TAG, "httpd_ws_recv_frame() failed: %s", esp_err_to_name(res));
+        return res;
+    }
+
+    if (frame.type != HTTPD_WS_TYPE_TEXT || !frame.len)
+        return ESP_OK;
+
+    char buf[64];
+
+    if (frame.len > sizeof(buf))
+    {
+        ESP_LOGW(TAG, "message from %d too long (%zu)", fd, frame.len);
+        return ESP_OK;
+    }
+
+    frame.payload = reinterpret_cast<uint8_t*>(buf);
+
+    if (const auto res = httpd_ws_recv_frame(req, &frame, frame.len); res != ESP_OK)
+    {
+        ESP_LOGE(TAG, "httpd_ws_recv_frame() failed: %s", esp_err_to_name(res));
+        return res;
+    }
+
+    handleMessage(fd, std::string_view{buf, frame.len});
+
+    return ESP_OK;
+}
+
+std::string configDelta()
+{
+    static StaticJsonDocument<256> value;
+    static StaticJsonDocument<384> entry;
+
+    std::string delta;
+
+    // strings can be rewritten by the http and mqtt tasks while they are serialized
+    espcpputils::RecursiveLockHelper guard{global::global_lock->handle};
+
+    configs.callForEveryConfig([&](auto& config) {
+        value.clear();
+
+        if (const auto res = apihelpers::toJson(config.value(), value); !res)
+            return false;
+
+        entry.clear();
+        entry["value"] = value;
+        entry["type"] = typeutils::t_to_str<std::decay_t<decltype(config.value())>>::str;
+        entry["touched"] = config.touched();
+
+        std::string json;
+        serializeJson(entry, json);
+
+        auto& last = lastConfig[config.nvsName()];
+        if (last == json)
+            return false;
+
+        delta += std::format(R"({}"{}":{})", delta.empty() ? "" : ",", config.nvsName(), json);
+        last = std::move(json);
+
+        return false;
+    });
+
+    return delta;
+}
+
+std::string statusDelta()
+{
+    std::string delta;
+
+    // forEveryKey() flattens nested objects to "parent/child", the delta nests them again
+    // like /api/v1/status, parent is the object currently open in delta
+    std::string parent;
+
+    const auto comma = [&delta]() {
+        if (!delta.empty() && delta.back() != '{')
+            delta += ',';
+    };
+
+    const auto enter = [&](const std::string_view name) {
+        if (parent == name)
+            return;
+
+        if (!parent.empty())
+            delta += '}';
+
+        parent = name;
+
+        if (!parent.empty())
+        {
+            comma();
+            delta += std::format(R"("{}":{{)", parent);
+        }
+    };
+
+    espcpputils::RecursiveLockHelper guard{global::global_lock->handle};
+
+    status::forEveryKey([&](const JsonString& key, const JsonVariant& value) {
+        std::string json;
+        serializeJson(value, json);
+
+        auto& last = lastStatus[key.c_str()];
+        if (last == json)
+            return;
+
+        const std::string_view path{key.c_str()};
+        const auto slash = path.find('/');
+
+        enter(slash == std::string_view::npos ? std::string_view{} : path.substr(0, slash));
+
+        comma();
+        delta += std::format(R"("{}":{})", slash == std::string_view::npos ? path : path.substr(slash + 1), json);
+
+        last = std::move(json);
+    });
+
+    enter({});
+
+    return delta;
+}
+
+} // namespace
+
+void webserver_ws_setup(httpd_handle_t handle)
+{
+    clientsLock.construct();
+
+    serverHandle = handle;
+
+    const httpd_uri_t handler{
+        .uri = "/api/v1/ws",
+        .method = HTTP_GET,
+        .handler = ws_handler,
+        .user_ctx = nullptr,
+        .is_websocket = true,
+    };
+
+    ESP_LOGI(TAG, "Registering URI handler for %s", handler.uri);
+    if (const auto res = httpd_register_uri_handler(handle, &handler); res != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to register URI handler for %s: %s", handler.uri, esp_err_to_name(res));
+    }
+}
+
+void webserver_ws_update()
+{
+    if (!serverHandle)
+        return;
+
+    // keep the config cache current even without clients, it is the base for the next delta
+    if (configChanged.consume())
+    {
+        auto delta = configDelta();
+
+        if (!delta.empty())
+        {
+            std::vector<int> fds;
+
+            {
+                espcpputils::RecursiveLockHelper guard{clientsLock->handle};
+                for (auto& client : clients)
+                    if (client.fd >= 0 && httpd_ws_get_fd_info(serverHandle, client.fd) == HTTPD_WS_CLIENT_WEBSOCKET)
+                        fds.push_back(client.fd);
+            }
+
+            broadcast(fds, std::format(R"({{"type":"config","data":{{{}}}}})", delta), HTTPD_WS_TYPE_TEXT);
+        }
+    }
+
+    const auto now = espchrono::millis_clock::now();
+
+    std::vector<int> connected;
+    std::vector<int> wantLeds;
+
+    {
+        espcpputils::RecursiveLockHelper guard{clientsLock->handle};
+
+        for (auto& client : clients)
+        {
+            if (client.fd < 0)
+                continue;
+
+            if (httpd_ws_get_fd_info(serverHandle, client.fd) != HTTPD_WS_CLIENT_WEBSOCKET)
+            {
+                ESP_LOGI(TAG, "client %d disconnected", client.fd);
+                client = Client{};
+                continue;
+            }
+
+            connected.push_back(client.fd);
+
+            if (client.ledInterval.count() && now - client.lastLeds >= client.ledInterval)
+                wantLeds.push_back(client.fd);
+        }
+    }
+
+    if (connected.empty())
+        return;
+
+    if (const auto fullStatus = clientConnected.exchange(false); fullStatus || now - lastStatusPush >= statusInterval)
+    {
+        if (fullStatus)
+            lastStatus.clear();
+
+        lastStatusPush = now;
+
+        if (auto delta = statusDelta(); !delta.empty())
+            broadcast(connected, std::format(R"({{"type":"status","data":{{{}}}}})", delta), HTTPD_WS_TYPE_TEXT);
+    }
+
+    if (wantLeds.empty())
+        return;
+
+    std::string frame;
+    uint32_t frameNumber;
+
+    {
+        espcpputils::RecursiveLockHelper ledLockHelper{ledmanager::led_lock->handle};
+
+        const auto& leds = ledmanager::getLeds();
+        frameNumber = ledmanager::previewFrame();
+
+        frame.resize(sizeof(frameNumber) + leds.size() * 3);
+        std::memcpy(frame.data(), &frameNumber, sizeof(frameNumber));
+        std::memcpy(frame.data() + sizeof(frameNumber), leds.data(), leds.size() * 3);
+    }
+
+    {
+        espcpputils::RecursiveLockHelper guard{clientsLock->handle};
+
+        // only the clients that have not seen this frame yet
+        std::erase_if(wantLeds, [&](const int fd) {
+            const auto iter = std::find_if(std::begin(clients), std::end(clients), [fd](const Client& client) { return client.fd == fd; });
+            if (iter == std::end(clients) || iter->ledFrame == frameNumber)
+                return true;
+
+            iter->ledFrame = frameNumber;
+            iter->lastLeds = now;
+            return false;
+        });
+    }
+
+    broadcast(wantLeds, std::move(frame), HTTPD_WS_TYPE_BINARY);
+}
+
+} // namespace webserver
@@ -0,0 +1,19 @@
+#pragma once
+
+// esp-idf includes
+#include <esp_http_server.h>
+
+namespace webserver {
+
+// /api/v1/ws pushes changes instead of having dashboards poll. Text frames carry
+// {"type":"status"|"config","data":{...}} with only the keys that changed, nested like
+// /api/v1/status and /api/v1/config. A nested status object only holds its changed keys,
+// clients merge it into what they have. Binary frames are led frames, the preview
+// frame counter (uint32 le) followed by raw rgb. A client asks for them with {"leds":<ms>},
+// 0 turns them off again.
+void webserver_ws_setup(httpd_handle_t handle);
+
+// encodes pending changes once and queues them for every connected client
+void webserver_ws_update();
+
+} // namespace webserver
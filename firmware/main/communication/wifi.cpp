@@ -3,6 +3,7 @@
 constexpr const char * const TAG = "WIFI";
 
 // system includes
+#include <algorithm>
 #include <expected>
 #include <string>
 #include <optional>
@@ -16,6 +17,7 @@ constexpr const char * const TAG = "WIFI";
 
 // local includes
 #include "utils/config.h"
+#include "utils/configsubscription.h"
 #include "utils/espclock.h"
 #include "utils/global_lock.h"
 
@@ -30,6 +32,26 @@ std::optional<wifi_stack::ap_config> createApConfig();
 
 bool lastStaConnected{false};
 
+bool isWiFiConfig(const ConfigWrapperInterface& config)
+{
+    using configutils::isAnyOf;
+
+    if (isAnyOf(config, configs.hostname, configs.baseMacAddressOverride, configs.wifiStaEnabled,
+                configs.wifiApEnabled, configs.wifiApOnlyWhenNotConnected, configs.wifiApName, configs.wifiApKey,
+                configs.wifiApChannel, configs.wifiApIp, configs.wifiApMask, configs.wifiApAuthmode))
+        return true;
+
+    return std::ranges::any_of(configs.wifis, [&config](const WiFiConfig& wifi) {
+        return isAnyOf(config, wifi.ssid, wifi.key, wifi.useStaticIp, wifi.staticIp, wifi.staticSubnet,
+                       wifi.staticGateway, wifi.useStaticDns, wifi.staticDns0, wifi.staticDns1, wifi.staticDns2);
+    });
+}
+
+configutils::ConfigSubscription wifiConfigChanged{isWiFiConfig};
+
+// only rebuilt when a wifi config or the sta connection (for wifiApOnlyWhenNotConnected) changed
+wifi_stack::config lastConfig;
+
 } // namespace
 
 void begin()
@@ -42,11 +64,14 @@ void begin()
 void update()
 {
     espcpputils::RecursiveLockHelper guard{global::global_lock->handle};
-    wifi_stack::update(createConfig());
+
+    bool configChanged = wifiConfigChanged.consume();
 
     if (const bool connected = isStaConnected(); connected != lastStaConnected)
     {
         lastStaConnected = connected;
+        configChanged = true;
+
         if (connected)
         {
             ESP_LOGI(TAG, "STA connected");
@@ -55,6 +80,11 @@ void update()
         else
             ESP_LOGI(TAG, "STA disconnected");
     }
+
+    if (configChanged)
+        lastConfig = createConfig();
+
+    wifi_stack::update(lastConfig);
 }
 
 std::expected<void, std::string> startScan()
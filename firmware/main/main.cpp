@@ -1,5 +1,8 @@
 constexpr const char * const TAG = "main";
 
+// system includes
+#include <algorithm>
+
 // esp-idf includes
 #include <esp_log.h>
 #include <freertos/FreeRTOS.h>
@@ -13,6 +16,7 @@ constexpr const char * const TAG = "main";
 // local includes
 #include "utils/config.h"
 #include "utils/global_lock.h"
+#include "utils/logbuffer.h"
 #include "utils/tasks.h"
 
 /*--- Config Flag Error Handling ---*/
@@ -34,6 +38,9 @@ extern "C" [[noreturn]] void app_main()
 {
     ESP_LOGI(TAG, "app_main()");
 
+    /*--- Logging ---*/
+    logbuffer::begin();
+
     /*--- Task Watchdog ---*/
 #if defined(CONFIG_ESP_TASK_WDT_PANIC) || defined(CONFIG_ESP_TASK_WDT)
     {
@@ -70,8 +77,7 @@ extern "C" [[noreturn]] void app_main()
 
 
     /*--- Task Manager ---*/
-    for (const auto& task : tasks)
-        task.setup();
+    sched_begin();
 
 #if defined(CONFIG_ESP_TASK_WDT_PANIC) || defined(CONFIG_ESP_TASK_WDT)
     if (const auto result = esp_task_wdt_reset(); result != ESP_OK)
@@ -82,22 +88,15 @@ extern "C" [[noreturn]] void app_main()
 
     while (true)
     {
-        for (auto& task : tasks)
-        {
-            task.loop();
-
-#if defined(CONFIG_ESP_TASK_WDT_PANIC) || defined(CONFIG_ESP_TASK_WDT)
-            if (const auto result = esp_task_wdt_reset(); result != ESP_OK)
-                ESP_LOGE(TAG, "esp_task_wdt_reset() failed with %s", esp_err_to_name(result));
-#endif
-        }
+        sched_loop();
 
-        if (espchrono::ago(lastTaskPush) > 1s)
+        if (espchrono::ago(lastTaskPush) >= 1s)
         {
             lastTaskPush = espchrono::millis_clock::now();
             sched_pushStats(false);
         }
 
-        vTaskDelay(1);
+        // sleep until the next task is due instead of waking up every tick
+        sched_waitUntil(std::min(sched_nextDeadline(), lastTaskPush + 1s));
     }
 }
@@ -60,7 +60,7 @@ void handleLed(Led& led, ledc_channel_t channel)
     const auto actualMaxDuty = MAX_DUTY * configuredBrightness / 100;
     const auto duty = led.current * actualMaxDuty / 100;
 
-    ESP_LOGI(TAG, "led.current: %d, actualMaxDuty: %d, duty: %d", led.current, actualMaxDuty, duty);
+    ESP_LOGV(TAG, "led.current: %d, actualMaxDuty: %d, duty: %d", led.current, actualMaxDuty, duty);
 
     ledc_set_duty(LEDC_HIGH_SPEED_MODE, channel, duty);
     ledc_update_duty(LEDC_HIGH_SPEED_MODE, channel);
@@ -18,6 +18,9 @@ constexpr const char * const TAG = "sensors::bme280";
 #include <cleanuphelper.h>
 #include <espchrono.h>
 
+// local includes
+#include "utils/taskplacement.h"
+
 namespace bme280_sensor {
 
 BME280 bme280;
@@ -131,7 +134,10 @@ void bmx280_task(void*)
 
 void begin()
 {
-    xTaskCreate(bmx280_task, "bme280_update_task", 4096, nullptr, 5, &update_task_handle);
+    if (const auto result = taskplacement::createTask(bmx280_task, "bme280Read", nullptr, &update_task_handle); result != pdPASS)
+    {
+        ESP_LOGE(TAG, "failed creating update task %d", result);
+    }
 }
 
 std::string BME280::toString() const
@@ -0,0 +1,160 @@
+#include "customeffectanimation.h"
+
+constexpr const char * const TAG = "customeffect";
+
+// esp-idf includes
+#include <esp_log.h>
+
+// local includes
+#include "utils/config.h"
+#include "utils/configsubscription.h"
+#include "utils/renderconfig.h"
+
+namespace animation {
+
+namespace {
+
+using effectvm::fixed_t;
+using effectvm::ONE;
+
+// effect programs count segments from A to G, SevenSegmentDigit::Segment starts at F
+constexpr std::array<fixed_t, SevenSegmentDigit::LAST_SEGMENT + 1> segmentNumbers{
+    5 * ONE, // F
+    6 * ONE, // G
+    4 * ONE, // E
+    3 * ONE, // D
+    2 * ONE, // C
+    1 * ONE, // B
+    0 * ONE, // A
+};
+
+// starts out changed, the first update() parses the stored program
+configutils::ConfigSubscription programChanged{[](const ConfigWrapperInterface& config) {
+    return configutils::isAnyOf(config, configs.customEffect);
+}};
+
+} // namespace
+
+void CustomEffectAnimation::init(CRGB* leds, const size_t leds_length)
+{
+    m_leds = leds;
+    m_ledsLength = leds_length;
+}
+
+void CustomEffectAnimation::update()
+{
+    Base::update();
+
+    if (programChanged.consume())
+    {
+        if (auto program = effectvm::parse(configs.customEffect.value()); program)
+        {
+            m_program = std::move(*program);
+        }
+        else
+        {
+            ESP_LOGE(TAG, "Invalid effect program: %.*s", program.error().size(), program.error().data());
+            m_program.reset();
+        }
+    }
+
+    // milliseconds to Q16.16 seconds, wraps every 32768s to stay in range
+    constexpr int64_t wrapMs = 32768LL * 1000;
+    const int64_t ms = espchrono::millis_clock::now().time_since_epoch().count() % wrapMs;
+    m_time = static_cast<fixed_t>(ms * ONE / 1000);
+
+    const auto& config = renderconfig::get();
+
+    m_palette = {config.primaryColor, config.secondaryColor, config.tertiaryColor};
+}
+
+void CustomEffectAnimation::renderSpan(CRGB* begin, CRGB* end, effectvm::Inputs& inputs) const
+{
+    const auto length = static_cast<fixed_t>(end - begin);
+
+    if (m_program->mode == effectvm::Mode::PerSegment)
+    {
+        inputs.index = static_cast<fixed_t>(begin - m_leds) * ONE;
+        inputs.pos = inputs.index / static_cast<fixed_t>(m_ledsLength);
+        inputs.segmentPos = 0;
+
+        std::fill(begin, end, effectvm::run(*m_program, inputs, m_palette));
+        return;
+    }
+
+    for (auto* led = begin; led != end; ++led)
+    {
+        const auto offset = static_cast<fixed_t>(led - begin);
+
+        inputs.index = static_cast<fixed_t>(led - m_leds) * ONE;
+        inputs.pos = inputs.index / static_cast<fixed_t>(m_ledsLength);
+        inputs.segmentPos = length > 1 ? offset * ONE / (length - 1) : 0;
+
+        *led = effectvm::run(*m_program, inputs, m_palette);
+    }
+}
+
+void CustomEffectAnimation::render_segments(std::span<SevenSegmentDigit> digits)
+{
+    Base::render_segments(digits);
+
+    if (!m_program)
+    {
+        for (const auto& digit : digits)
+            std::fill(digit.begin(), digit.end(), CRGB::Black);
+        return;
+    }
+
+    // digit, segment and lit are set per segment below, the rest per led by renderSpan()
+    effectvm::Inputs inputs{
+        .index = 0,
+        .count = static_cast<fixed_t>(m_ledsLength) * ONE,
+        .pos = 0,
+        .time = m_time,
+        .digit = 0,
+        .segment = 0,
+        .lit = 0,
+        .segmentPos = 0,
+    };
+
+    for (size_t digitIndex = 0; digitIndex < digits.size(); ++digitIndex)
+    {
+        const auto& digit = digits[digitIndex];
+
+        inputs.digit = static_cast<fixed_t>(digitIndex) * ONE;
+
+        for (const auto& span : digit.segments())
+        {
+            inputs.segment = segmentNumbers[span.segment];
+            inputs.lit = digit.segmentOn(span.segment) ? ONE : 0;
+
+            renderSpan(span.begin, span.end, inputs);
+        }
+    }
+}
+
+void CustomEffectAnimation::render_dot(ClockDot& clockDot, CRGB* leds, const size_t leds_length)
+{
+    Base::render_dot(clockDot, leds, leds_length);
+
+    if (!m_program)
+    {
+        std::fill(clockDot.begin(), clockDot.end(), CRGB::Black);
+        return;
+    }
+
+    effectvm::Inputs inputs{
+        .index = 0,
+        .count = static_cast<fixed_t>(m_ledsLength) * ONE,
+        .pos = 0,
+        .time = m_time,
+        .digit = -ONE,
+        .segment = -ONE,
+        .lit = clockDot.on() ? ONE : 0,
+        .segmentPos = 0,
+    };
+
+    renderSpan(clockDot.begin(), clockDot.end(), inputs);
+}
+
+} // namespace animation
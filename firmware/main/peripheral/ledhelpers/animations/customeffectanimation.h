@@ -0,0 +1,43 @@
+#pragma once
+
+// system includes
+#include <optional>
+
+// local includes
+#include "peripheral/ledhelpers/effectvm.h"
+#include "peripheral/ledhelpers/ledanimation.h"
+
+namespace animation {
+
+// runs the effect program uploaded in the customEffect config
+class CustomEffectAnimation : public LedAnimation
+{
+    using Base = LedAnimation;
+
+    espchrono::milliseconds32 getUpdateInterval() const override { return espchrono::milliseconds32{20}; }
+
+    constexpr RenderType renderType() const override { return RenderType::ForEverySegment; }
+
+    void update() override;
+
+    void render_segments(std::span<SevenSegmentDigit> digits) override;
+
+    void render_dot(ClockDot& clockDot, CRGB* leds, size_t leds_length) override;
+
+    std::optional<LedAnimationName> getEnumValue() const override { return LedAnimationName::CustomEffect; }
+
+private:
+    void init(CRGB* leds, size_t leds_length) override;
+
+    void renderSpan(CRGB* begin, CRGB* end, effectvm::Inputs& inputs) const;
+
+    CRGB* m_leds{};
+    size_t m_ledsLength{};
+
+    std::optional<effectvm::Program> m_program;
+
+    effectvm::fixed_t m_time{};
+    effectvm::Palette m_palette{};
+};
+
+} // namespace animation
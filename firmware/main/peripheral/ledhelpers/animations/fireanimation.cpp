@@ -0,0 +1,41 @@
+#include "fireanimation.h"
+
+namespace animation {
+
+void FireAnimation::update()
+{
+    Base::update();
+
+    constexpr uint8_t cooling = 12;
+    constexpr uint8_t sparks = 4;
+
+    // diffuse, every led keeps half of its heat and takes a quarter from each neighbour
+    uint8_t previous = m_heat.front();
+    for (size_t i = 0; i < m_heat.size(); ++i)
+    {
+        const uint8_t next = i + 1 < m_heat.size() ? m_heat[i + 1] : m_heat[i];
+        const uint8_t current = m_heat[i];
+
+        m_heat[i] = qsub8((previous + 2 * current + next) >> 2, random8(cooling));
+
+        previous = current;
+    }
+
+    for (uint8_t i = 0; i < sparks; ++i)
+    {
+        auto& heat = m_heat[random16(m_heat.size())];
+        heat = qadd8(heat, random8(96, 255));
+    }
+}
+
+void FireAnimation::render_all(CRGB* leds, const size_t leds_length)
+{
+    Base::render_all(leds, leds_length);
+
+    for (size_t i = 0; i < std::min(leds_length, m_heat.size()); ++i)
+    {
+        leds[i] = HeatColor(m_heat[i]);
+    }
+}
+
+} // namespace animation
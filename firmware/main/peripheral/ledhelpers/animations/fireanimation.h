@@ -0,0 +1,30 @@
+#pragma once
+
+// system includes
+#include <array>
+
+// local includes
+#include "peripheral/ledhelpers/ledanimation.h"
+
+namespace animation {
+
+// embers that flare up at random leds and spread their heat to the neighbours
+class FireAnimation : public LedAnimation
+{
+    using Base = LedAnimation;
+
+    espchrono::milliseconds32 getUpdateInterval() const override { return espchrono::milliseconds32{30}; }
+
+    constexpr RenderType renderType() const override { return RenderType::AllAtOnce; }
+
+    void update() override;
+
+    void render_all(CRGB* leds, size_t leds_length) override;
+
+    std::optional<LedAnimationName> getEnumValue() const override { return LedAnimationName::Fire; }
+
+private:
+    std::array<uint8_t, std::tuple_size_v<ledmanager::LedArray>> m_heat{};
+};
+
+} // namespace animation
@@ -0,0 +1,34 @@
+#include "noiseanimation.h"
+
+// local includes
+#include "peripheral/ledhelpers/fixedmath.h"
+#include "utils/renderconfig.h"
+
+namespace animation {
+
+void NoiseAnimation::update()
+{
+    Base::update();
+
+    m_time += 12;
+
+    const auto& config = renderconfig::get();
+
+    m_from = config.primaryColor;
+    m_to = config.secondaryColor;
+}
+
+void NoiseAnimation::render_all(CRGB* leds, const size_t leds_length)
+{
+    Base::render_all(leds, leds_length);
+
+    // about 5 leds per lattice cell
+    constexpr uint16_t scale = 48;
+
+    for (size_t i = 0; i < leds_length; ++i)
+    {
+        leds[i] = blend(m_from, m_to, fixedmath::noise8(i * scale, m_time));
+    }
+}
+
+} // namespace animation
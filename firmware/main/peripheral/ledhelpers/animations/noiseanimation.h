@@ -0,0 +1,30 @@
+#pragma once
+
+// local includes
+#include "peripheral/ledhelpers/ledanimation.h"
+
+namespace animation {
+
+// slowly moving value noise between the primary and secondary color
+class NoiseAnimation : public LedAnimation
+{
+    using Base = LedAnimation;
+
+    espchrono::milliseconds32 getUpdateInterval() const override { return espchrono::milliseconds32{30}; }
+
+    constexpr RenderType renderType() const override { return RenderType::AllAtOnce; }
+
+    void update() override;
+
+    void render_all(CRGB* leds, size_t leds_length) override;
+
+    std::optional<LedAnimationName> getEnumValue() const override { return LedAnimationName::Noise; }
+
+private:
+    uint16_t m_time{};
+
+    CRGB m_from{};
+    CRGB m_to{};
+};
+
+} // namespace animation
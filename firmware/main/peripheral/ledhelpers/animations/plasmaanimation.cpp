@@ -0,0 +1,34 @@
+#include "plasmaanimation.h"
+
+// local includes
+#include "peripheral/ledhelpers/fixedmath.h"
+
+namespace animation {
+
+using fixedmath::sine8;
+
+void PlasmaAnimation::update()
+{
+    Base::update();
+
+    m_phase1 += 3;
+    m_phase2 -= 2;
+    m_phase3 += 1;
+}
+
+void PlasmaAnimation::render_all(CRGB* leds, const size_t leds_length)
+{
+    Base::render_all(leds, leds_length);
+
+    for (size_t i = 0; i < leds_length; ++i)
+    {
+        const uint16_t sum = sine8(i * 3 + m_phase1) + sine8(i * 7 + m_phase2) + sine8(sine8(i * 2 + m_phase3) + m_phase1);
+
+        // sum / 3 without a division
+        const uint8_t hue = (sum * 85) >> 8;
+
+        hsv2rgb_rainbow(CHSV{hue, 255, 255}, leds[i]);
+    }
+}
+
+} // namespace animation
@@ -0,0 +1,29 @@
+#pragma once
+
+// local includes
+#include "peripheral/ledhelpers/ledanimation.h"
+
+namespace animation {
+
+// three sine waves with different wavelengths drifting against each other
+class PlasmaAnimation : public LedAnimation
+{
+    using Base = LedAnimation;
+
+    espchrono::milliseconds32 getUpdateInterval() const override { return espchrono::milliseconds32{20}; }
+
+    constexpr RenderType renderType() const override { return RenderType::AllAtOnce; }
+
+    void update() override;
+
+    void render_all(CRGB* leds, size_t leds_length) override;
+
+    std::optional<LedAnimationName> getEnumValue() const override { return LedAnimationName::Plasma; }
+
+private:
+    uint8_t m_phase1{};
+    uint8_t m_phase2{};
+    uint8_t m_phase3{};
+};
+
+} // namespace animation
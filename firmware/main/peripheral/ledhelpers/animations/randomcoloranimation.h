@@ -11,6 +11,8 @@ class RandomColorAnimation : public LedAnimation
 
     espchrono::milliseconds32 getUpdateInterval() const override { return espchrono::milliseconds32{16}; }
 
+    espchrono::milliseconds32 getFrameInterval() const override { return espchrono::milliseconds32{250}; }
+
     constexpr RenderType renderType() const override { return RenderType::AllAtOnce; }
 
     void update() override;
@@ -11,6 +11,8 @@ class StaticColorAnimation : public LedAnimation
 
     espchrono::milliseconds32 getUpdateInterval() const override { return espchrono::milliseconds32{0}; }
 
+    espchrono::milliseconds32 getFrameInterval() const override { return espchrono::milliseconds32{250}; }
+
     constexpr RenderType renderType() const override { return RenderType::AllAtOnce; }
 
     cpputils::ColorHelper getPrimaryColor() const override { return cpputils::ColorHelper{0, 0, 0}; }
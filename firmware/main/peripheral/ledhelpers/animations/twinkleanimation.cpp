@@ -0,0 +1,39 @@
+#include "twinkleanimation.h"
+
+// local includes
+#include "utils/renderconfig.h"
+
+namespace animation {
+
+void TwinkleAnimation::update()
+{
+    Base::update();
+
+    constexpr uint8_t fade = 235;
+    constexpr uint8_t newTwinkles = 2;
+
+    for (auto& level : m_levels)
+    {
+        level = scale8(level, fade);
+    }
+
+    for (uint8_t i = 0; i < newTwinkles; ++i)
+    {
+        m_levels[random16(m_levels.size())] = 255;
+    }
+
+    m_color = renderconfig::get().primaryColor;
+}
+
+void TwinkleAnimation::render_all(CRGB* leds, const size_t leds_length)
+{
+    Base::render_all(leds, leds_length);
+
+    for (size_t i = 0; i < std::min(leds_length, m_levels.size()); ++i)
+    {
+        leds[i] = m_color;
+        leds[i].nscale8_video(m_levels[i]);
+    }
+}
+
+} // namespace animation
@@ -0,0 +1,32 @@
+#pragma once
+
+// system includes
+#include <array>
+
+// local includes
+#include "peripheral/ledhelpers/ledanimation.h"
+
+namespace animation {
+
+// random leds light up in the primary color and fade out again
+class TwinkleAnimation : public LedAnimation
+{
+    using Base = LedAnimation;
+
+    espchrono::milliseconds32 getUpdateInterval() const override { return espchrono::milliseconds32{30}; }
+
+    constexpr RenderType renderType() const override { return RenderType::AllAtOnce; }
+
+    void update() override;
+
+    void render_all(CRGB* leds, size_t leds_length) override;
+
+    std::optional<LedAnimationName> getEnumValue() const override { return LedAnimationName::Twinkle; }
+
+private:
+    std::array<uint8_t, std::tuple_size_v<ledmanager::LedArray>> m_levels{};
+
+    CRGB m_color{};
+};
+
+} // namespace animation
@@ -0,0 +1,49 @@
+#include "blend.h"
+
+// system includes
+#include <cstring>
+
+namespace {
+
+constexpr uint32_t evenBytes = 0x00FF00FF;
+
+// blends 4 packed channel bytes at once, every byte gets a 16 bit lane so the
+// products cannot carry into the neighbouring channel (255 * 256 < 65536)
+inline uint32_t blendWord(const uint32_t from, const uint32_t to, const uint32_t amount)
+{
+    const uint32_t inverse = 256 - amount;
+
+    const uint32_t even = (((from & evenBytes) * inverse + (to & evenBytes) * amount) >> 8) & evenBytes;
+    const uint32_t odd = (((from >> 8) & evenBytes) * inverse + ((to >> 8) & evenBytes) * amount) & ~evenBytes;
+
+    return even | odd;
+}
+
+} // namespace
+
+void blendLeds(const CRGB* from, const CRGB* to, CRGB* out, const size_t length, const uint16_t amount)
+{
+    // channels are blended independently, so the word boundaries do not need to line up with the leds
+    const auto* fromBytes = reinterpret_cast<const uint8_t*>(from);
+    const auto* toBytes = reinterpret_cast<const uint8_t*>(to);
+    auto* outBytes = reinterpret_cast<uint8_t*>(out);
+
+    const size_t byteCount = length * sizeof(CRGB);
+
+    size_t i = 0;
+
+    for (; i + sizeof(uint32_t) <= byteCount; i += sizeof(uint32_t))
+    {
+        uint32_t fromWord, toWord;
+        std::memcpy(&fromWord, fromBytes + i, sizeof(uint32_t));
+        std::memcpy(&toWord, toBytes + i, sizeof(uint32_t));
+
+        const uint32_t result = blendWord(fromWord, toWord, amount);
+        std::memcpy(outBytes + i, &result, sizeof(uint32_t));
+    }
+
+    for (; i < byteCount; ++i)
+    {
+        outBytes[i] = (fromBytes[i] * (256 - amount) + toBytes[i] * amount) >> 8;
+    }
+}
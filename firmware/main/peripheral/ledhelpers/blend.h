@@ -0,0 +1,12 @@
+#pragma once
+
+// system includes
+#include <cstddef>
+#include <cstdint>
+
+// 3rdparty lib includes
+#include <FastLED.h>
+
+// linear blend between two frames, amount goes from 0 (only from) to 256 (only to).
+// out may alias from or to.
+void blendLeds(const CRGB* from, const CRGB* to, CRGB* out, size_t length, uint16_t amount);
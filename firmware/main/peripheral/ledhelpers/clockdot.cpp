@@ -1,19 +1,15 @@
 #include "clockdot.h"
 
-// system includes
-#include <algorithm>
-
 // local includes
-#include "utils/config.h"
+#include "utils/renderconfig.h"
 
 ClockDot::ClockDot(const DotPlacement placement, CRGB* startLed, const size_t length)
     : m_startLed{startLed}, m_length{length}, m_on{false}, m_placement{placement}
 {}
 
-void ClockDot::render() const
+bool ClockDot::visible() const
 {
-    if (!m_on || !configs.ledOverrideDigits.value().empty())
-        std::fill_n(m_startLed, m_length, CRGB::Black);
+    return m_on && !renderconfig::get().overrideDigitsActive;
 }
 
 std::string ClockDot::toString() const
@@ -17,7 +17,8 @@ public:
 
     explicit ClockDot(DotPlacement placement, CRGB* startLed, size_t length);
 
-    void render() const;
+    // on and not hidden by the override text
+    bool visible() const;
 
     void on(const bool on) { m_on = on; }
 
@@ -0,0 +1,121 @@
+#include "compositor.h"
+
+// system includes
+#include <algorithm>
+
+void Compositor::setOpacity(const CompositorLayer layer, const uint8_t opacity)
+{
+    auto& entry = m_layers[index(layer)];
+
+    if (entry.opacity == opacity)
+        return;
+
+    entry.opacity = opacity;
+    entry.dirty = true;
+}
+
+void Compositor::setBlendMode(const CompositorLayer layer, const BlendMode blendMode)
+{
+    auto& entry = m_layers[index(layer)];
+
+    if (entry.blendMode == blendMode)
+        return;
+
+    entry.blendMode = blendMode;
+    entry.dirty = true;
+}
+
+bool Compositor::covered(const CompositorLayer layer) const
+{
+    return std::any_of(m_layers.begin() + index(layer) + 1, m_layers.end(), [](const Layer& above) {
+        return above.opacity == 255 && above.blendMode == BlendMode::Normal;
+    });
+}
+
+bool Compositor::compose(CRGB* out)
+{
+    // the topmost opaque layer replaces everything below, blending starts there
+    size_t first = 0;
+
+    for (size_t i = LayerCount; i-- > 0;)
+    {
+        if (m_layers[i].opacity == 255 && m_layers[i].blendMode == BlendMode::Normal)
+        {
+            first = i;
+            break;
+        }
+    }
+
+    const bool changed = m_invalidated || std::any_of(m_layers.begin() + first, m_layers.end(), [](const Layer& layer) {
+        return layer.dirty;
+    });
+
+    if (!changed)
+        return false;
+
+    std::fill_n(out, HARDWARE_WS2812B_COUNT, CRGB::Black);
+
+    for (size_t i = first; i < LayerCount; ++i)
+    {
+        if (m_layers[i].opacity > 0)
+        {
+            blend(m_layers[i], out);
+        }
+    }
+
+    // hidden layers stay dirty, they show up again once the cover is gone
+    for (size_t i = first; i < LayerCount; ++i)
+    {
+        m_layers[i].dirty = false;
+    }
+
+    m_invalidated = false;
+
+    return true;
+}
+
+void Compositor::blend(const Layer& layer, CRGB* out)
+{
+    const auto opacity = layer.opacity;
+    const auto* in = layer.pixels.data();
+
+    switch (layer.blendMode)
+    {
+    case BlendMode::Normal:
+        if (opacity == 255)
+        {
+            std::copy_n(in, HARDWARE_WS2812B_COUNT, out);
+            break;
+        }
+
+        for (size_t i = 0; i < HARDWARE_WS2812B_COUNT; ++i)
+        {
+            nblend(out[i], in[i], opacity);
+        }
+        break;
+    case BlendMode::Add:
+        for (size_t i = 0; i < HARDWARE_WS2812B_COUNT; ++i)
+        {
+            out[i] += CRGB{in[i]}.nscale8_video(opacity);
+        }
+        break;
+    case BlendMode::Multiply:
+        // a partly transparent mask fades towards white, which leaves the pixels below as they are
+        for (size_t i = 0; i < HARDWARE_WS2812B_COUNT; ++i)
+        {
+            out[i].r = scale8(out[i].r, 255 - scale8(255 - in[i].r, opacity));
+            out[i].g = scale8(out[i].g, 255 - scale8(255 - in[i].g, opacity));
+            out[i].b = scale8(out[i].b, 255 - scale8(255 - in[i].b, opacity));
+        }
+        break;
+    case BlendMode::Lighten:
+        for (size_t i = 0; i < HARDWARE_WS2812B_COUNT; ++i)
+        {
+            const auto scaled = CRGB{in[i]}.nscale8_video(opacity);
+            out[i].r = std::max(out[i].r, scaled.r);
+            out[i].g = std::max(out[i].g, scaled.g);
+            out[i].b = std::max(out[i].b, scaled.b);
+        }
+        break;
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+// system includes
+#include <array>
+#include <cstdint>
+
+// 3rdparty lib includes
+#include <FastLED.h>
+#include <cpptypesafeenum.h>
+
+// bottom to top
+#define CompositorLayerValues(x) \
+    x(Base) \
+    x(Digits) \
+    x(Notification) \
+    x(System)
+DECLARE_GLOBAL_TYPESAFE_ENUM(CompositorLayer, : uint8_t, CompositorLayerValues);
+
+#define BlendModeValues(x) \
+    x(Normal) \
+    x(Add) \
+    x(Multiply) \
+    x(Lighten)
+DECLARE_GLOBAL_TYPESAFE_ENUM(BlendMode, : uint8_t, BlendModeValues);
+
+// Fixed stack of full-frame layers. Every layer keeps its pixels between frames, owners only
+// repaint and mark a layer dirty when its content changed, the stack is only blended when
+// at least one visible layer is dirty.
+class Compositor
+{
+public:
+    using Pixels = std::array<CRGB, HARDWARE_WS2812B_COUNT>;
+
+    static constexpr size_t LayerCount = static_cast<size_t>(CompositorLayer::System) + 1;
+
+    Pixels& pixels(const CompositorLayer layer) { return m_layers[index(layer)].pixels; }
+
+    const Pixels& pixels(const CompositorLayer layer) const { return m_layers[index(layer)].pixels; }
+
+    // 0 hides the layer, 255 blends it at full strength
+    void setOpacity(CompositorLayer layer, uint8_t opacity);
+
+    uint8_t opacity(const CompositorLayer layer) const { return m_layers[index(layer)].opacity; }
+
+    void setBlendMode(CompositorLayer layer, BlendMode blendMode);
+
+    BlendMode blendMode(const CompositorLayer layer) const { return m_layers[index(layer)].blendMode; }
+
+    void markDirty(const CompositorLayer layer) { m_layers[index(layer)].dirty = true; }
+
+    bool dirty(const CompositorLayer layer) const { return m_layers[index(layer)].dirty; }
+
+    // an opaque Normal layer above hides this one completely, its owner can skip rendering
+    bool covered(CompositorLayer layer) const;
+
+    // blends the visible layers bottom up into out, returns false when nothing changed since the last call
+    bool compose(CRGB* out);
+
+    // re-blends on the next compose() even if no layer changed, for when out was overwritten
+    void invalidate() { m_invalidated = true; }
+
+private:
+    struct Layer
+    {
+        Pixels pixels{};
+        uint8_t opacity{255};
+        BlendMode blendMode{BlendMode::Normal};
+        bool dirty{true};
+    };
+
+    static constexpr size_t index(const CompositorLayer layer) { return static_cast<size_t>(layer); }
+
+    static void blend(const Layer& layer, CRGB* out);
+
+    std::array<Layer, LayerCount> m_layers{};
+
+    bool m_invalidated{true};
+};
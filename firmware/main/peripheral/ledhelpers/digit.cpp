@@ -4,13 +4,10 @@
 #include <algorithm>
 #include <format>
 
-// local includes
-#include "digithelper.h"
-
-SevenSegmentDigit::SevenSegmentDigit(CRGB* startLed, const size_t length, const size_t ledsPerSegment) :
+SevenSegmentDigit::SevenSegmentDigit(CRGB* startLed, const size_t length, const SegmentOffsets& segmentOffsets, const size_t ledsPerSegment) :
     m_startLed{startLed},
     m_length{length},
-    m_ledsPerSegment{ledsPerSegment},
+    m_segments{},
     m_isStaticColor{true},
     m_segmentColors{
         CRGB::White,
@@ -21,19 +18,28 @@ SevenSegmentDigit::SevenSegmentDigit(CRGB* startLed, const size_t length, const
         CRGB::White,
         CRGB::White,
     }
-{}
-
-void SevenSegmentDigit::renderMask() const
 {
-    const uint8_t mask = digithelper::getSegmentMask(m_digit.value_or(' '));
+    for (auto segment = static_cast<Segment>(0); segment <= LAST_SEGMENT; segment = static_cast<Segment>(segment + 1))
+    {
+        CRGB* begin = m_startLed + segmentOffsets[segment];
+        m_segments[segment] = SegmentSpan{segment, begin, begin + ledsPerSegment};
+    }
+}
 
-    if (mask & 0b00000001) /*fillSegment(A, m_segmentColors[A]);*/{} else clearSegment(A);
-    if (mask & 0b00000010) /*fillSegment(B, m_segmentColors[B]);*/{} else clearSegment(B);
-    if (mask & 0b00000100) /*fillSegment(C, m_segmentColors[C]);*/{} else clearSegment(C);
-    if (mask & 0b00001000) /*fillSegment(D, m_segmentColors[D]);*/{} else clearSegment(D);
-    if (mask & 0b00010000) /*fillSegment(E, m_segmentColors[E]);*/{} else clearSegment(E);
-    if (mask & 0b00100000) /*fillSegment(F, m_segmentColors[F]);*/{} else clearSegment(F);
-    if (mask & 0b01000000) /*fillSegment(G, m_segmentColors[G]);*/{} else clearSegment(G);
+bool SevenSegmentDigit::segmentInMask(const uint8_t mask, const Segment segment)
+{
+    // segment masks count from A (bit 0) to G (bit 6)
+    constexpr std::array<uint8_t, LAST_SEGMENT + 1> maskBits{
+        0b00100000, // F
+        0b01000000, // G
+        0b00010000, // E
+        0b00001000, // D
+        0b00000100, // C
+        0b00000010, // B
+        0b00000001, // A
+    };
+
+    return mask & maskBits[segment];
 }
 
 /*
@@ -47,15 +53,6 @@ void SevenSegmentDigit::renderMask() const
 
  */
 
-void SevenSegmentDigit::fillSegment(const Segment segment, const CRGB &color) const
-{
-    const size_t start = segment * m_ledsPerSegment;
-    const size_t end = start + m_ledsPerSegment;
-
-    ESP_LOGD("SevenSegmentDigit", "fillSegment: start=%d, end=%d, color=rgb(%d, %d, %d)", start, end, color.r, color.g, color.b);
-    std::fill(m_startLed + start, m_startLed + end, color);
-}
-
 std::string SevenSegmentDigit::toString() const
 {
     char c = m_digit.value_or(' ');
@@ -65,18 +62,3 @@ std::string SevenSegmentDigit::toString() const
 
     return std::format("SevenSegmentDigit(digit={})", c);
 }
-
-void SevenSegmentDigit::forEverySegment(const std::function<void(Segment, CRGB*, CRGB*, size_t)>& func) const
-{
-    for (auto segment = static_cast<Segment>(0); segment <= LAST_SEGMENT; segment = static_cast<Segment>(segment + 1))
-    {
-        const size_t start = segment * m_ledsPerSegment;
-        const size_t end = start + m_ledsPerSegment;
-
-        CRGB* startLed = m_startLed + start;
-        CRGB* endLed = m_startLed + end;
-        const size_t length = end - start;
-
-        func(segment, startLed, endLed, length);
-    }
-}
@@ -6,18 +6,47 @@
 #include <cstdint>
 #include <optional>
 #include <string>
-#include <functional>
 
 // 3rdparty lib includes
 #include <FastLED.h>
 
+// local includes
+#include "digithelper.h"
+
 class SevenSegmentDigit
 {
 public:
-    explicit SevenSegmentDigit(CRGB* startLed, size_t length, size_t ledsPerSegment = 8);
+    enum Segment
+    {
+        F = 0,
+        G,
+        E,
+        D,
+        C,
+        B,
+        A,
+        LAST_SEGMENT = A,
+        ALL_SEGMENTS = -1,
+    };
 
-    SevenSegmentDigit(CRGB* startLed, const size_t length, const CRGB& color, const size_t ledsPerSegment = 8)
-        : SevenSegmentDigit{startLed, length, ledsPerSegment}
+    struct SegmentSpan
+    {
+        Segment segment;
+        CRGB* begin;
+        CRGB* end;
+
+        size_t length() const { return end - begin; }
+    };
+
+    using SegmentSpans = std::array<SegmentSpan, LAST_SEGMENT + 1>;
+
+    // offset of every segment from the start of the digit, indexed by Segment
+    using SegmentOffsets = std::array<size_t, LAST_SEGMENT + 1>;
+
+    explicit SevenSegmentDigit(CRGB* startLed, size_t length, const SegmentOffsets& segmentOffsets, size_t ledsPerSegment);
+
+    SevenSegmentDigit(CRGB* startLed, const size_t length, const SegmentOffsets& segmentOffsets, const size_t ledsPerSegment, const CRGB& color)
+        : SevenSegmentDigit{startLed, length, segmentOffsets, ledsPerSegment}
     {
         setColor(color);
     }
@@ -31,6 +60,7 @@ public:
         if (m_digit != c)
         {
             m_digit = c;
+            m_mask = digithelper::getSegmentMask(c);
             return true;
         }
 
@@ -41,9 +71,16 @@ public:
     {
         setColor(color);
 
-        if (m_digit != c)
+        return setChar(c);
+    }
+
+    // lights exactly the segments of a digithelper mask, for glyphs without a character
+    bool setMask(const uint8_t mask)
+    {
+        if (m_digit || m_mask != mask)
         {
-            m_digit = c;
+            m_digit.reset();
+            m_mask = mask;
             return true;
         }
 
@@ -56,26 +93,20 @@ public:
         m_isStaticColor = true;
     }
 
-    void clear() { m_digit.reset(); }
+    void clear() { setMask(0); }
 
-    void renderMask() const;
+    // digithelper segment mask of the current character
+    uint8_t mask() const { return m_mask; }
 
-    std::string toString() const;
+    // whether the current character lights up the segment
+    bool segmentOn(Segment segment) const { return segmentInMask(mask(), segment); }
 
-    enum Segment
-    {
-        F = 0,
-        G,
-        E,
-        D,
-        C,
-        B,
-        A,
-        LAST_SEGMENT = A,
-        ALL_SEGMENTS = -1,
-    };
+    static bool segmentInMask(uint8_t mask, Segment segment);
 
-    void forEverySegment(const std::function<void(Segment, CRGB*, CRGB*, size_t)>& func) const;
+    std::string toString() const;
+
+    // precomputed at construction, indexed by Segment
+    const SegmentSpans& segments() const { return m_segments; }
 
     size_t length() const { return m_length; }
 
@@ -85,19 +116,18 @@ public:
 
 private:
 
-    void fillSegment(Segment segment, const CRGB& color) const;
-
-    void clearSegment(const Segment segment) const { fillSegment(segment, CRGB::Black); }
-
     // void setSegmentAnimation(Segment segment, animation_t animation);
 
     CRGB* m_startLed;
     size_t m_length;
-    size_t m_ledsPerSegment;
+
+    SegmentSpans m_segments;
 
     bool m_isStaticColor;
 
     std::array<CRGB, 7> m_segmentColors;
 
     std::optional<char> m_digit;
+
+    uint8_t m_mask{};
 };
@@ -1,8 +1,8 @@
 #pragma once
 
 // system includes
+#include <array>
 #include <cstdint>
-#include <map>
 
 namespace digithelper {
 
@@ -17,8 +17,87 @@ enum SegmentMask : uint8_t
     G = 1 << 6,
 };
 
-extern std::map<char, uint8_t> SEGMENT_MASKS;
+/*
+ One segment
 
-uint8_t getSegmentMask(char c);
+   A
+ F   B
+   G
+ E   C
+   D
+
+ */
+
+struct CharSegmentMask
+{
+    char c;
+    uint8_t mask;
+};
+
+inline constexpr CharSegmentMask CHAR_SEGMENT_MASKS[] = {
+    {'0', A | B | C | D | E | F},
+    {'1', B | C},
+    {'2', A | B | D | E | G},
+    {'3', A | B | C | D | G},
+    {'4', B | C | F | G},
+    {'5', A | C | D | F | G},
+    {'6', A | C | D | E | F | G},
+    {'7', A | B | C},
+    {'8', A | B | C | D | E | F | G},
+    {'9', A | B | C | D | F | G},
+    {'A', A | B | C | E | F | G},
+    {'B', C | D | E | F | G},
+    {'C', A | D | E | F},
+    {'D', B | C | D | E | G},
+    {'E', A | D | E | F | G},
+    {'F', A | E | F | G},
+    {'G', A | C | D | E | F},
+    {'H', B | C | E | F | G},
+    {'I', B | C},
+    {'J', B | C | D | E},
+    {'K', E | F | G},
+    {'L', D | E | F},
+    {'M', A | C | E},
+    {'N', C | E | G},
+    {'O', A | B | C | D | E | F},
+    {'P', A | B | E | F | G},
+    {'Q', A | B | C | F | G},
+    {'R', E | G},
+    {'S', A | C | D | F | G},
+    {'T', D | E | F | G},
+    {'U', B | C | D | E | F},
+    {'V', C | D | E},
+    {'W', B | D | F},
+    {'X', B | C | E | F | G},
+    {'Y', B | C | D | F | G},
+    {'Z', A | B | D | E | G},
+    {' ', 0},
+    {'-', G},
+    {'_', D},
+};
+
+// one entry per ascii character, lowercase letters share the uppercase masks
+inline constexpr std::array<uint8_t, 128> SEGMENT_MASKS = [] {
+    std::array<uint8_t, 128> masks{};
+
+    for (const auto& [c, mask] : CHAR_SEGMENT_MASKS)
+    {
+        masks[c] = mask;
+
+        if (c >= 'A' && c <= 'Z')
+        {
+            masks[c - 'A' + 'a'] = mask;
+        }
+    }
+
+    return masks;
+}();
+
+constexpr uint8_t getSegmentMask(const char c)
+{
+    const auto index = static_cast<unsigned char>(c);
+
+    return index < SEGMENT_MASKS.size() ? SEGMENT_MASKS[index] : 0;
+}
 
 } // namespace digithelper
@@ -0,0 +1,251 @@
+#include "effectvm.h"
+
+// system includes
+#include <algorithm>
+#include <format>
+#include <utility>
+
+// local includes
+#include "fixedmath.h"
+
+namespace effectvm {
+
+namespace {
+
+struct OpcodeInfo
+{
+    uint8_t immediateSize;
+    uint8_t pops;
+    uint8_t pushes;
+    bool output;
+};
+
+constexpr std::optional<OpcodeInfo> opcodeInfo(const uint8_t opcode)
+{
+    switch (static_cast<Opcode>(opcode))
+    {
+    case Opcode::Push: return OpcodeInfo{4, 0, 1, false};
+    case Opcode::PushInt:
+    case Opcode::PushFrac: return OpcodeInfo{1, 0, 1, false};
+    case Opcode::Index:
+    case Opcode::Count:
+    case Opcode::Pos:
+    case Opcode::Time:
+    case Opcode::Digit:
+    case Opcode::Segment:
+    case Opcode::Lit:
+    case Opcode::SegmentPos: return OpcodeInfo{0, 0, 1, false};
+    case Opcode::Add:
+    case Opcode::Sub:
+    case Opcode::Mul:
+    case Opcode::Div:
+    case Opcode::Mod:
+    case Opcode::Min:
+    case Opcode::Max: return OpcodeInfo{0, 2, 1, false};
+    case Opcode::Neg:
+    case Opcode::Abs:
+    case Opcode::Frac:
+    case Opcode::Sin:
+    case Opcode::Tri:
+    case Opcode::Clamp: return OpcodeInfo{0, 1, 1, false};
+    case Opcode::Dup: return OpcodeInfo{0, 1, 2, false};
+    case Opcode::Swap: return OpcodeInfo{0, 2, 2, false};
+    case Opcode::Drop: return OpcodeInfo{0, 1, 0, false};
+    case Opcode::Over: return OpcodeInfo{0, 2, 3, false};
+    case Opcode::Rgb:
+    case Opcode::Hsv: return OpcodeInfo{0, 3, 0, true};
+    case Opcode::Palette: return OpcodeInfo{0, 1, 0, true};
+    }
+
+    return std::nullopt;
+}
+
+constexpr std::optional<uint8_t> hexNibble(const char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return std::nullopt;
+}
+
+// uploaded programs may overflow, the arithmetic wraps around in unsigned math instead of being undefined
+constexpr fixed_t wrapping(const uint32_t value)
+{
+    return static_cast<fixed_t>(value);
+}
+
+// 0 to 1 mapped to 0 to 255, saturating
+uint8_t toChannel(const fixed_t value)
+{
+    return std::clamp<int32_t>((static_cast<int64_t>(value) * 255) >> 16, 0, 255);
+}
+
+CRGB paletteLookup(const Palette& palette, const fixed_t position)
+{
+    // three stops on a closed loop, the last one blends back into the first
+    const uint32_t scaled = static_cast<uint32_t>(position & 0xFFFF) * palette.size();
+    const size_t stop = scaled >> 16;
+    const uint8_t amount = (scaled >> 8) & 0xFF;
+
+    return blend(palette[stop], palette[(stop + 1) % palette.size()], amount);
+}
+
+} // namespace
+
+std::expected<Program, std::string> parse(const std::string_view hex)
+{
+    if (hex.size() % 2)
+        return std::unexpected("Program must have an even number of hex digits");
+
+    if (hex.size() / 2 > MAX_PROGRAM_SIZE)
+        return std::unexpected(std::format("Program must not be longer than {} bytes", MAX_PROGRAM_SIZE));
+
+    if (hex.size() < 6)
+        return std::unexpected("Program is too short");
+
+    std::vector<uint8_t> bytes;
+    bytes.reserve(hex.size() / 2);
+
+    for (size_t i = 0; i < hex.size(); i += 2)
+    {
+        const auto high = hexNibble(hex[i]);
+        const auto low = hexNibble(hex[i + 1]);
+
+        if (!high || !low)
+            return std::unexpected(std::format("Invalid hex digit at {}", i));
+
+        bytes.push_back(*high << 4 | *low);
+    }
+
+    if (bytes[0] != VERSION)
+        return std::unexpected(std::format("Unsupported program version {}", bytes[0]));
+
+    if (bytes[1] > std::to_underlying(Mode::PerSegment))
+        return std::unexpected(std::format("Unsupported program mode {}", bytes[1]));
+
+    Program program{
+        .mode = static_cast<Mode>(bytes[1]),
+        .code = std::vector<uint8_t>(bytes.begin() + 2, bytes.end()),
+    };
+
+    const auto& code = program.code;
+
+    size_t depth = 0;
+
+    for (size_t pc = 0; pc < code.size();)
+    {
+        const auto info = opcodeInfo(code[pc]);
+
+        if (!info)
+            return std::unexpected(std::format("Unknown opcode 0x{:02x} at {}", code[pc], pc));
+
+        if (pc + 1 + info->immediateSize > code.size())
+            return std::unexpected(std::format("Missing immediate at {}", pc));
+
+        if (depth < info->pops)
+            return std::unexpected(std::format("Stack underflow at {}", pc));
+
+        depth = depth - info->pops + info->pushes;
+
+        if (depth > MAX_STACK_DEPTH)
+            return std::unexpected(std::format("Stack overflow at {}", pc));
+
+        const auto next = pc + 1 + info->immediateSize;
+
+        if (info->output != (next == code.size()))
+            return std::unexpected(std::format("Program has to end with exactly one output instruction (at {})", pc));
+
+        pc = next;
+    }
+
+    return program;
+}
+
+CRGB run(const Program& program, const Inputs& inputs, const Palette& palette)
+{
+    // parse() guarantees the stack never under- or overflows and the code ends in an output
+    std::array<fixed_t, MAX_STACK_DEPTH> stack;
+    size_t sp = 0;
+
+    const uint8_t* pc = program.code.data();
+
+    const auto push = [&](const fixed_t value) { stack[sp++] = value; };
+    const auto pop = [&]() { return stack[--sp]; };
+
+    while (true)
+    {
+        switch (static_cast<Opcode>(*pc++))
+        {
+        case Opcode::Push: {
+            const uint32_t value = pc[0] | pc[1] << 8 | pc[2] << 16 | static_cast<uint32_t>(pc[3]) << 24;
+            pc += 4;
+            push(static_cast<fixed_t>(value));
+            break;
+        }
+        case Opcode::PushInt: push(static_cast<fixed_t>(*pc++) << 16); break;
+        case Opcode::PushFrac: push(static_cast<fixed_t>(*pc++) << 8); break;
+
+        case Opcode::Index: push(inputs.index); break;
+        case Opcode::Count: push(inputs.count); break;
+        case Opcode::Pos: push(inputs.pos); break;
+        case Opcode::Time: push(inputs.time); break;
+        case Opcode::Digit: push(inputs.digit); break;
+        case Opcode::Segment: push(inputs.segment); break;
+        case Opcode::Lit: push(inputs.lit); break;
+        case Opcode::SegmentPos: push(inputs.segmentPos); break;
+
+        case Opcode::Add: { const auto b = pop(); push(wrapping(static_cast<uint32_t>(pop()) + static_cast<uint32_t>(b))); break; }
+        case Opcode::Sub: { const auto b = pop(); push(wrapping(static_cast<uint32_t>(pop()) - static_cast<uint32_t>(b))); break; }
+        case Opcode::Mul: { const auto b = pop(); push((static_cast<int64_t>(pop()) * b) >> 16); break; }
+        case Opcode::Div: {
+            const auto b = pop();
+            const auto a = pop();
+            push(b ? static_cast<fixed_t>((static_cast<int64_t>(a) << 16) / b) : 0);
+            break;
+        }
+        case Opcode::Mod: {
+            const auto b = pop();
+            const auto a = pop();
+            // INT32_MIN % -1 overflows, the result is 0 for every a anyway
+            push(b && b != -1 ? a % b : 0);
+            break;
+        }
+        case Opcode::Neg: push(wrapping(0u - static_cast<uint32_t>(pop()))); break;
+        case Opcode::Abs: { const auto a = pop(); push(a < 0 ? wrapping(0u - static_cast<uint32_t>(a)) : a); break; }
+        case Opcode::Min: { const auto b = pop(); push(std::min(pop(), b)); break; }
+        case Opcode::Max: { const auto b = pop(); push(std::max(pop(), b)); break; }
+        case Opcode::Frac: push(pop() & 0xFFFF); break;
+        case Opcode::Sin: push(static_cast<fixed_t>(fixedmath::sine16(pop() & 0xFFFF)) * 2); break;
+        case Opcode::Tri: {
+            const auto phase = pop() & 0xFFFF;
+            push(phase < 0x8000 ? phase * 2 : (0xFFFF - phase) * 2);
+            break;
+        }
+        case Opcode::Clamp: push(std::clamp(pop(), 0, ONE)); break;
+
+        case Opcode::Dup: { const auto a = pop(); push(a); push(a); break; }
+        case Opcode::Swap: { const auto b = pop(); const auto a = pop(); push(b); push(a); break; }
+        case Opcode::Drop: pop(); break;
+        case Opcode::Over: { const auto b = pop(); const auto a = pop(); push(a); push(b); push(a); break; }
+
+        case Opcode::Rgb: {
+            const auto b = pop();
+            const auto g = pop();
+            const auto r = pop();
+            return CRGB{toChannel(r), toChannel(g), toChannel(b)};
+        }
+        case Opcode::Hsv: {
+            const auto v = pop();
+            const auto s = pop();
+            const auto h = pop();
+            return CHSV{static_cast<uint8_t>((h & 0xFFFF) >> 8), toChannel(s), toChannel(v)};
+        }
+        case Opcode::Palette: return paletteLookup(palette, pop());
+        }
+    }
+}
+
+} // namespace effectvm
@@ -0,0 +1,111 @@
+#pragma once
+
+// system includes
+#include <array>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 3rdparty lib includes
+#include <FastLED.h>
+
+// Small stack machine for effects that are uploaded at runtime instead of compiled in.
+//
+// A program is a 2 byte header (version, mode) followed by straight-line code, there are
+// no jumps so every program terminates and its stack usage is known when it is parsed.
+// All values are Q16.16 fixed point and wrap around on overflow, the last instruction has to
+// be an output opcode.
+// Keep firmware/tools/effect-asm in sync with the opcode numbers below.
+namespace effectvm {
+
+using fixed_t = int32_t;
+
+constexpr fixed_t ONE = 1 << 16;
+
+constexpr uint8_t VERSION = 1;
+
+constexpr size_t MAX_PROGRAM_SIZE = 512;
+constexpr size_t MAX_STACK_DEPTH = 16;
+
+enum class Mode : uint8_t
+{
+    // program runs once for every led
+    PerLed = 0,
+    // program runs once for every segment and dot, the result fills all of its leds
+    PerSegment = 1,
+};
+
+enum class Opcode : uint8_t
+{
+    // immediates
+    Push = 0x01,        // 4 byte little endian Q16.16
+    PushInt = 0x02,     // 1 byte integer
+    PushFrac = 0x03,    // 1 byte, value / 256
+
+    // inputs
+    Index = 0x10,       // led index in the strip
+    Count = 0x11,       // led count of the strip
+    Pos = 0x12,         // index / count
+    Time = 0x13,        // seconds, wraps every 32768s
+    Digit = 0x14,       // 0 to 3, -1 for the dots
+    Segment = 0x15,     // 0 (A) to 6 (G), -1 for the dots
+    Lit = 0x16,         // 1 if the segment or dot is shown
+    SegmentPos = 0x17,  // position inside the segment or dot, 0 to 1
+
+    // arithmetic
+    Add = 0x20,
+    Sub = 0x21,
+    Mul = 0x22,
+    Div = 0x23,         // division by zero yields 0
+    Mod = 0x24,         // modulo zero yields 0
+    Neg = 0x25,
+    Abs = 0x26,
+    Min = 0x27,
+    Max = 0x28,
+    Frac = 0x29,
+    Sin = 0x2A,         // one period per 1.0, -1 to 1
+    Tri = 0x2B,         // triangle wave, one period per 1.0, 0 to 1
+    Clamp = 0x2C,       // clamps to 0 to 1
+
+    // stack
+    Dup = 0x30,
+    Swap = 0x31,
+    Drop = 0x32,
+    Over = 0x33,
+
+    // outputs, terminate the program
+    Rgb = 0x40,         // r g b, 0 to 1 each
+    Hsv = 0x41,         // h s v, 0 to 1 each, hue wraps
+    Palette = 0x42,     // position in the primary/secondary/tertiary gradient, wraps
+};
+
+struct Program
+{
+    Mode mode;
+    std::vector<uint8_t> code;
+};
+
+struct Inputs
+{
+    fixed_t index;
+    fixed_t count;
+    fixed_t pos;
+    fixed_t time;
+    fixed_t digit;
+    fixed_t segment;
+    fixed_t lit;
+    fixed_t segmentPos;
+};
+
+using Palette = std::array<CRGB, 3>;
+
+// decodes a hex encoded program and checks every instruction and the stack usage,
+// programs that pass can be run without any further checks
+std::expected<Program, std::string> parse(std::string_view hex);
+
+CRGB run(const Program& program, const Inputs& inputs, const Palette& palette);
+
+} // namespace effectvm
@@ -0,0 +1,19 @@
+#include "fixedmath.h"
+
+namespace fixedmath {
+
+namespace {
+
+static_assert(sine16(0) == 0);
+static_assert(sine16(16384) == 32767);
+static_assert(sine16(49152) == -32767);
+static_assert(cosine16(0) == 32767);
+static_assert(sine8(0) == 128);
+static_assert(sine8(64) == 255);
+static_assert(sine8(192) == 0);
+static_assert(SMOOTHSTEP_TABLE[0] == 0 && SMOOTHSTEP_TABLE[255] == 255);
+static_assert(noise8(0x1200, 0x3400) == hash8(0x12 | 0x34 << 16));
+
+} // namespace
+
+} // namespace fixedmath
@@ -0,0 +1,124 @@
+#pragma once
+
+// system includes
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Table backed integer math for the procedural animations and the effect VM.
+// Everything is constexpr, so the tables end up in flash and not in RAM.
+// (names avoid sin8/sin16, FastLED defines those as macros)
+namespace fixedmath {
+
+namespace detail {
+
+constexpr double pi = 3.14159265358979323846;
+
+// only used to build the tables, x in [-pi, pi]
+constexpr double sine(double x)
+{
+    // fold into [-pi/2, pi/2] where the series converges quickly
+    if (x > pi / 2)
+        x = pi - x;
+    else if (x < -pi / 2)
+        x = -pi - x;
+
+    const double x2 = x * x;
+    double term = x;
+    double sum = x;
+
+    for (int n = 1; n < 10; ++n)
+    {
+        term *= -x2 / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+
+    return sum;
+}
+
+} // namespace detail
+
+// one period in 256 steps plus a guard entry for interpolation, -32767 to 32767
+inline constexpr std::array<int16_t, 257> SINE_TABLE = []() {
+    std::array<int16_t, 257> table{};
+
+    for (size_t i = 0; i < table.size(); ++i)
+    {
+        double x = 2 * detail::pi * i / 256;
+        if (x > detail::pi)
+            x -= 2 * detail::pi;
+
+        const double value = detail::sine(x) * 32767;
+        table[i] = static_cast<int16_t>(value >= 0 ? value + 0.5 : value - 0.5);
+    }
+
+    return table;
+}();
+
+// 3t^2 - 2t^3 over 0 to 255, softens the lattice edges of the value noise
+inline constexpr std::array<uint8_t, 256> SMOOTHSTEP_TABLE = []() {
+    std::array<uint8_t, 256> table{};
+
+    for (uint32_t t = 0; t < table.size(); ++t)
+    {
+        table[t] = (3 * t * t * 255 - 2 * t * t * t) / (255 * 255);
+    }
+
+    return table;
+}();
+
+// phase 0 to 65535 is one period, returns -32767 to 32767
+constexpr int16_t sine16(const uint16_t phase)
+{
+    const int32_t a = SINE_TABLE[phase >> 8];
+    const int32_t b = SINE_TABLE[(phase >> 8) + 1];
+
+    return a + (((b - a) * (phase & 0xFF)) >> 8);
+}
+
+constexpr int16_t cosine16(const uint16_t phase)
+{
+    return sine16(phase + 16384);
+}
+
+// phase 0 to 255 is one period, returns 0 to 255 centered on 128
+constexpr uint8_t sine8(const uint8_t phase)
+{
+    return (SINE_TABLE[phase] >> 8) + 128;
+}
+
+constexpr uint8_t lerp8(const uint8_t a, const uint8_t b, const uint8_t amount)
+{
+    return a + (((b - a) * amount) >> 8);
+}
+
+// integer hash, decorrelates neighbouring lattice points
+constexpr uint8_t hash8(uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+
+    return x;
+}
+
+// 2D value noise, coordinates are 8.8 fixed point (one lattice cell per 256), returns 0 to 255
+constexpr uint8_t noise8(const uint16_t x, const uint16_t y)
+{
+    const uint32_t cellX = x >> 8;
+    const uint32_t cellY = y >> 8;
+
+    const uint8_t fx = SMOOTHSTEP_TABLE[x & 0xFF];
+    const uint8_t fy = SMOOTHSTEP_TABLE[y & 0xFF];
+
+    const auto corner = [](const uint32_t cx, const uint32_t cy) { return hash8(cx | cy << 16); };
+
+    const uint8_t top = lerp8(corner(cellX, cellY), corner(cellX + 1, cellY), fx);
+    const uint8_t bottom = lerp8(corner(cellX, cellY + 1), corner(cellX + 1, cellY + 1), fx);
+
+    return lerp8(top, bottom, fy);
+}
+
+} // namespace fixedmath
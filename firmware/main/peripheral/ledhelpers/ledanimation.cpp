@@ -6,16 +6,20 @@ constexpr const char * const TAG = "ledanimation";
 #include "arrayview.h"
 
 // local includes
-#include "communication/ota.h"
-#include "peripheral/ledhelpers/animations/internal/otaanimation.h"
 #include "utils/config.h"
+#include "utils/renderconfig.h"
 
 // animations
+#include "peripheral/ledhelpers/animations/customeffectanimation.h"
+#include "peripheral/ledhelpers/animations/fireanimation.h"
 #include "peripheral/ledhelpers/animations/newyearanimation.h"
+#include "peripheral/ledhelpers/animations/noiseanimation.h"
+#include "peripheral/ledhelpers/animations/plasmaanimation.h"
 #include "peripheral/ledhelpers/animations/rainbowanimation.h"
 #include "peripheral/ledhelpers/animations/randomcoloranimation.h"
 #include "peripheral/ledhelpers/animations/staticcoloranimation.h"
 #include "peripheral/ledhelpers/animations/stroboanimation.h"
+#include "peripheral/ledhelpers/animations/twinkleanimation.h"
 
 namespace animation {
 
@@ -25,12 +29,23 @@ LedAnimation* animationsArr[]{
     new NewYearAnimation(),
     new StroboAnimation(),
     new RandomColorAnimation(),
+    new CustomEffectAnimation(),
+    new FireAnimation(),
+    new PlasmaAnimation(),
+    new NoiseAnimation(),
+    new TwinkleAnimation(),
 };
 
 cpputils::ArrayView<LedAnimation*> animations{animationsArr};
 
 LedAnimation* currentAnimation{nullptr};
 
+LedAnimation* previousAnimation{nullptr};
+
+namespace {
+espchrono::millis_clock::time_point transitionStart;
+} // namespace
+
 const LedAnimation& getFirstAnimation()
 {
     return *animations[0];
@@ -40,29 +55,29 @@ std::expected<void, std::string> updateAnimation(const LedAnimationName enumValu
 {
     LedAnimation* newAnimation{nullptr};
 
-    if (currentAnimation != nullptr && currentAnimation->getEnumValue() == enumValue && !ota::isInProgress())
+    if (currentAnimation != nullptr && currentAnimation->getEnumValue() == enumValue)
         return {};
 
-    if (ota::isInProgress())
-    {
-        newAnimation = internal::otaAnimation;
-    }
-    else
+    for (const auto animation: animations)
     {
-        for (const auto animation: animations)
+        if (animation->getEnumValue() == enumValue)
         {
-            if (animation->getEnumValue() == enumValue)
-            {
-                newAnimation = animation;
-                break;
-            }
+            newAnimation = animation;
+            break;
         }
     }
 
-
     if (newAnimation != nullptr)
     {
-        if (currentAnimation)
+        // a transition that is still running is cut, only the last two animations are blended
+        finishTransition(leds);
+
+        if (currentAnimation && configs.animationTransitionDuration.value())
+        {
+            previousAnimation = currentAnimation;
+            transitionStart = espchrono::millis_clock::now();
+        }
+        else if (currentAnimation)
         {
             // void stop(CRGB* startLed, CRGB* endLed)
             currentAnimation->stop(leds.data(), leds.size());
@@ -75,6 +90,39 @@ std::expected<void, std::string> updateAnimation(const LedAnimationName enumValu
     return std::unexpected(std::format("Animation '{}' not found ({})", toString(enumValue), std::to_underlying(enumValue)));
 }
 
+uint16_t transitionProgress()
+{
+    if (!previousAnimation)
+    {
+        return 256;
+    }
+
+    const auto duration = espchrono::milliseconds32{configs.animationTransitionDuration.value()};
+    const auto elapsed = espchrono::ago(transitionStart);
+
+    if (duration.count() <= 0 || elapsed >= duration)
+    {
+        return 256;
+    }
+
+    return elapsed * 256 / duration;
+}
+
+void finishTransition(ledmanager::LedArray& leds)
+{
+    if (!previousAnimation)
+    {
+        return;
+    }
+
+    if (previousAnimation != currentAnimation)
+    {
+        previousAnimation->stop(leds.data(), leds.size());
+    }
+
+    previousAnimation = nullptr;
+}
+
 bool animationExists(LedAnimationName enumValue)
 {
     return std::ranges::any_of(animations, [enumValue](const LedAnimation* animation) {
@@ -89,6 +137,6 @@ bool LedAnimation::needsUpdate() const
         return true;
     }
 
-    return espchrono::ago(*m_lastUpdate) > getUpdateInterval() / configs.animationMultiplier.value();
+    return espchrono::ago(*m_lastUpdate) > getUpdateInterval() / renderconfig::get().animationMultiplier;
 }
 } // namespace animation
@@ -3,6 +3,7 @@
 // system includes
 #include <expected>
 #include <optional>
+#include <span>
 #include <string>
 
 // 3rdparty lib includes
@@ -19,7 +20,12 @@
     x(StaticColor)                \
     x(NewYearAnimation)           \
     x(Strobo)                     \
-    x(RandomColor)
+    x(RandomColor)                \
+    x(CustomEffect)               \
+    x(Fire)                       \
+    x(Plasma)                     \
+    x(Noise)                      \
+    x(Twinkle)
 DECLARE_GLOBAL_TYPESAFE_ENUM(LedAnimationName, : uint8_t, LedAnimationNameValues);
 
 namespace animation {
@@ -53,7 +59,8 @@ public:
         m_lastUpdate = espchrono::millis_clock::now();
     }
 
-    virtual void render_segment(SevenSegmentDigit::Segment segment, SevenSegmentDigit& sevenSegmentDigit, CRGB* start_led, CRGB* end_led, size_t length)
+    // called once per frame with all digits, walk digit.segments() for the precomputed segment spans
+    virtual void render_segments(std::span<SevenSegmentDigit> digits)
     {
         m_lastRender = espchrono::millis_clock::now();
     }
@@ -77,6 +84,9 @@ public:
 
     virtual espchrono::milliseconds32 getUpdateInterval() const = 0;
 
+    // how often the output has to be refreshed while this animation is active
+    virtual espchrono::milliseconds32 getFrameInterval() const { return getUpdateInterval(); }
+
     virtual cpputils::ColorHelper getPrimaryColor() const { return cpputils::ColorHelper{0, 0, 0}; }
 
     virtual constexpr RenderType renderType() const { return RenderType::AllAtOnce; }
@@ -114,6 +124,15 @@ extern cpputils::ArrayView<LedAnimation*> animations;
 
 extern LedAnimation* currentAnimation;
 
+// the animation being faded out, only set while a transition is running
+extern LedAnimation* previousAnimation;
+
+// 0 (only previous) to 256 (only current)
+uint16_t transitionProgress();
+
+// stops the previous animation once the transition reached the current one
+void finishTransition(ledmanager::LedArray& leds);
+
 const LedAnimation& getFirstAnimation();
 
 std::expected<void, std::string> updateAnimation(LedAnimationName enumValue, ledmanager::LedArray& leds);
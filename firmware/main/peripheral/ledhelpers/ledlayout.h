@@ -0,0 +1,126 @@
+#pragma once
+
+// system includes
+#include <array>
+#include <cstddef>
+
+// local includes
+#include "digit.h"
+
+#if !defined(HARDWARE_LAYOUT_DIGIT_OFFSETS) || !defined(HARDWARE_LAYOUT_DOT_OFFSETS) || \
+    !defined(HARDWARE_LAYOUT_DOT_LENGTH) || !defined(HARDWARE_LAYOUT_LEDS_PER_SEGMENT) || \
+    !defined(HARDWARE_LAYOUT_SEGMENT_ORDER)
+
+#error "LED layout (digit offsets, dot offsets, dot length, leds per segment, segment order) must be defined."
+
+#endif
+
+namespace ledlayout {
+
+using Segment = SevenSegmentDigit::Segment;
+
+constexpr size_t DIGIT_COUNT = 4;
+constexpr size_t DOT_COUNT = 2;
+constexpr size_t SEGMENT_COUNT = Segment::LAST_SEGMENT + 1;
+
+// Physical description of one case variant. Offsets are led indices on the strip,
+// segmentOrder lists the segments in the order the strip runs through a digit.
+template<size_t LedCount, size_t LedsPerSegment, size_t DotLength>
+struct LedLayout
+{
+    static constexpr size_t ledCount = LedCount;
+    static constexpr size_t ledsPerSegment = LedsPerSegment;
+    static constexpr size_t digitLength = LedsPerSegment * SEGMENT_COUNT;
+    static constexpr size_t dotLength = DotLength;
+
+    std::array<size_t, DIGIT_COUNT> digitOffsets;
+    std::array<size_t, DOT_COUNT> dotOffsets; // top, bottom
+    std::array<Segment, SEGMENT_COUNT> segmentOrder;
+
+    // offset of every segment within a digit, indexed by Segment
+    constexpr SevenSegmentDigit::SegmentOffsets segmentOffsets() const
+    {
+        SevenSegmentDigit::SegmentOffsets offsets{};
+
+        for (size_t position = 0; position < SEGMENT_COUNT; ++position)
+        {
+            offsets[segmentOrder[position]] = position * ledsPerSegment;
+        }
+
+        return offsets;
+    }
+
+    constexpr bool segmentOrderIsPermutation() const
+    {
+        std::array<bool, SEGMENT_COUNT> seen{};
+
+        for (const auto segment : segmentOrder)
+        {
+            if (segment < 0 || static_cast<size_t>(segment) >= SEGMENT_COUNT || seen[segment])
+                return false;
+
+            seen[segment] = true;
+        }
+
+        return true;
+    }
+
+    // every led belongs to exactly one digit or dot
+    constexpr bool coversStripExactly() const
+    {
+        std::array<bool, LedCount> used{};
+
+        const auto claim = [&used](const size_t offset, const size_t length) {
+            if (offset + length > LedCount)
+                return false;
+
+            for (size_t i = offset; i < offset + length; ++i)
+            {
+                if (used[i])
+                    return false;
+
+                used[i] = true;
+            }
+
+            return true;
+        };
+
+        for (const auto offset : digitOffsets)
+        {
+            if (!claim(offset, digitLength))
+                return false;
+        }
+
+        for (const auto offset : dotOffsets)
+        {
+            if (!claim(offset, dotLength))
+                return false;
+        }
+
+        for (const auto isUsed : used)
+        {
+            if (!isUsed)
+                return false;
+        }
+
+        return true;
+    }
+};
+
+using BoardLayout = LedLayout<HARDWARE_WS2812B_COUNT, HARDWARE_LAYOUT_LEDS_PER_SEGMENT, HARDWARE_LAYOUT_DOT_LENGTH>;
+
+inline constexpr BoardLayout layout{
+    .digitOffsets{HARDWARE_LAYOUT_DIGIT_OFFSETS},
+    .dotOffsets{HARDWARE_LAYOUT_DOT_OFFSETS},
+    .segmentOrder = [] {
+        using enum SevenSegmentDigit::Segment;
+        return std::array<Segment, SEGMENT_COUNT>{HARDWARE_LAYOUT_SEGMENT_ORDER};
+    }(),
+};
+
+inline constexpr SevenSegmentDigit::SegmentOffsets segmentOffsets = layout.segmentOffsets();
+
+static_assert(layout.segmentOrderIsPermutation(), "HARDWARE_LAYOUT_SEGMENT_ORDER must name every segment exactly once");
+static_assert(layout.coversStripExactly(), "LED layout must cover all HARDWARE_WS2812B_COUNT leds exactly once");
+
+} // namespace ledlayout
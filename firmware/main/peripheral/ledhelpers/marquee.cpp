@@ -0,0 +1,78 @@
+#include "marquee.h"
+
+// system includes
+#include <cctype>
+
+// local includes
+#include "digithelper.h"
+
+bool Marquee::start(const std::string_view text, const size_t width, const espchrono::millis_clock::time_point now)
+{
+    if (active() && m_text == text && m_width == width)
+    {
+        return false;
+    }
+
+    m_text = text;
+    m_width = width;
+    m_start = now;
+
+    m_strip.clear();
+    m_strip.reserve(text.size() + width);
+
+    // same characters as LedManager::setText() shows, everything else stays blank
+    for (const char c : text)
+    {
+        m_strip.push_back(std::isalnum(static_cast<unsigned char>(c)) ? digithelper::getSegmentMask(c) : 0);
+    }
+
+    m_strip.insert(m_strip.end(), width, 0);
+
+    return true;
+}
+
+void Marquee::stop()
+{
+    m_text.clear();
+    m_strip.clear();
+    m_strip.shrink_to_fit();
+}
+
+bool Marquee::window(const espchrono::millis_clock::time_point now, const espchrono::milliseconds32 stepInterval,
+                     const uint8_t loops, const std::span<uint8_t> out) const
+{
+    if (!active() || stepInterval.count() <= 0)
+    {
+        return false;
+    }
+
+    const auto size = m_strip.size();
+
+    // every pass starts one step after the blank window, the text enters from the right
+    // and the pass ends once it left on the left
+    const size_t step = (now - m_start) / stepInterval;
+
+    if (loops && step >= size * loops)
+    {
+        return false;
+    }
+
+    const size_t position = (step + size - m_width + 1) % size;
+
+    for (size_t i = 0; i < out.size(); ++i)
+    {
+        out[i] = m_strip[(position + i) % size];
+    }
+
+    return true;
+}
+
+espchrono::milliseconds32 Marquee::untilNextStep(const espchrono::millis_clock::time_point now, const espchrono::milliseconds32 stepInterval) const
+{
+    if (stepInterval.count() <= 0)
+    {
+        return stepInterval;
+    }
+
+    return stepInterval - espchrono::milliseconds32{(now - m_start) % stepInterval};
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+// system includes
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 3rdparty lib includes
+#include <espchrono.h>
+
+// Scrolls a text that does not fit the digits from right to left. The segment masks of the
+// whole message plus one blank window are computed once in start(), a frame only derives the
+// position from the elapsed time and copies one window, whatever the length of the text.
+class Marquee
+{
+public:
+    // returns false if text is already scrolling, which then keeps its position
+    bool start(std::string_view text, size_t width, espchrono::millis_clock::time_point now);
+
+    void stop();
+
+    bool active() const { return !m_strip.empty(); }
+
+    // fills out with the masks of the visible window, returns false once loops passes are done
+    // (0 loops forever)
+    bool window(espchrono::millis_clock::time_point now, espchrono::milliseconds32 stepInterval, uint8_t loops,
+                std::span<uint8_t> out) const;
+
+    // until the window moves on
+    espchrono::milliseconds32 untilNextStep(espchrono::millis_clock::time_point now, espchrono::milliseconds32 stepInterval) const;
+
+private:
+    std::string m_text;
+
+    // text masks followed by width blanks, scrolled circularly
+    std::vector<uint8_t> m_strip;
+    size_t m_width{};
+
+    espchrono::millis_clock::time_point m_start{};
+};
@@ -0,0 +1,119 @@
+#include "outputstage.h"
+
+// system includes
+#include <cmath>
+
+namespace {
+
+// 3 bit bit-reversed sequence, spreads the rounding threshold evenly over 8 frames
+constexpr std::array<uint8_t, 8> ditherThresholds{16, 144, 80, 208, 48, 176, 112, 240};
+
+constexpr uint8_t roundingThreshold = 128;
+
+} // namespace
+
+void OutputStage::setGamma(const float gamma)
+{
+    if (gamma == m_gamma)
+        return;
+
+    m_gamma = gamma;
+    m_baseTablesDirty = true;
+}
+
+void OutputStage::setCorrection(const CRGB& correction)
+{
+    if (correction == m_correction)
+        return;
+
+    m_correction = correction;
+    m_baseTablesDirty = true;
+}
+
+void OutputStage::setBrightness(const uint8_t brightness)
+{
+    if (brightness == m_brightness)
+        return;
+
+    m_brightness = brightness;
+    m_tablesDirty = true;
+}
+
+void OutputStage::rebuildBaseTables()
+{
+    for (size_t channel = 0; channel < 3; ++channel)
+    {
+        const float correction = m_correction.raw[channel] / 255.f;
+
+        for (size_t value = 0; value < 256; ++value)
+        {
+            const float linear = std::pow(value / 255.f, m_gamma) * correction;
+            m_baseTables[channel][value] = static_cast<uint16_t>(std::lround(linear * (255 << 8)));
+        }
+    }
+
+    m_baseTablesDirty = false;
+    m_tablesDirty = true;
+}
+
+void OutputStage::rebuildTables()
+{
+    for (size_t channel = 0; channel < 3; ++channel)
+    {
+        for (size_t value = 0; value < 256; ++value)
+        {
+            m_tables[channel][value] = static_cast<uint32_t>(m_baseTables[channel][value]) * m_brightness / 255;
+        }
+    }
+
+    m_tablesDirty = false;
+}
+
+void OutputStage::apply(const CRGB* in, CRGB* out, const size_t length)
+{
+    if (m_baseTablesDirty)
+        rebuildBaseTables();
+
+    if (m_tablesDirty)
+        rebuildTables();
+
+    const auto& [red, green, blue] = m_tables;
+
+    uint32_t sumRed{}, sumGreen{}, sumBlue{};
+
+    if (!m_dithering)
+    {
+        for (size_t i = 0; i < length; ++i)
+        {
+            out[i].r = (red[in[i].r] + roundingThreshold) >> 8;
+            out[i].g = (green[in[i].g] + roundingThreshold) >> 8;
+            out[i].b = (blue[in[i].b] + roundingThreshold) >> 8;
+
+            sumRed += out[i].r;
+            sumGreen += out[i].g;
+            sumBlue += out[i].b;
+        }
+
+        m_channelSums = {sumRed, sumGreen, sumBlue};
+
+        return;
+    }
+
+    // neighbouring leds use different thresholds so the strip does not flicker in sync
+    for (size_t i = 0; i < length; ++i)
+    {
+        const uint8_t threshold = ditherThresholds[(m_frame + i) & 7];
+
+        out[i].r = (red[in[i].r] + threshold) >> 8;
+        out[i].g = (green[in[i].g] + threshold) >> 8;
+        out[i].b = (blue[in[i].b] + threshold) >> 8;
+
+        sumRed += out[i].r;
+        sumGreen += out[i].g;
+        sumBlue += out[i].b;
+    }
+
+    m_channelSums = {sumRed, sumGreen, sumBlue};
+
+    ++m_frame;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+// system includes
+#include <array>
+#include <cstdint>
+
+// 3rdparty lib includes
+#include <FastLED.h>
+
+// Final stage between the rendered frame and the strip. Gamma, color correction and
+// brightness are folded into one 256-entry table per channel with 8 fractional bits,
+// the fraction is either rounded away or spread over frames by temporal dithering.
+class OutputStage
+{
+public:
+    void setGamma(float gamma);
+
+    void setCorrection(const CRGB& correction);
+
+    void setBrightness(uint8_t brightness);
+
+    void setDithering(const bool dithering) { m_dithering = dithering; }
+
+    bool dithering() const { return m_dithering; }
+
+    // writes the output frame and sums up the output channel values on the way
+    void apply(const CRGB* in, CRGB* out, size_t length);
+
+    // per channel sum of the last output frame, input for the power estimate
+    const std::array<uint32_t, 3>& channelSums() const { return m_channelSums; }
+
+private:
+    // gamma and correction only, 8.8 fixed point
+    void rebuildBaseTables();
+
+    // base tables scaled by brightness, 8.8 fixed point
+    void rebuildTables();
+
+    using ChannelTables = std::array<std::array<uint16_t, 256>, 3>;
+
+    float m_gamma{1.f};
+    CRGB m_correction{255, 255, 255};
+    uint8_t m_brightness{255};
+    bool m_dithering{};
+
+    bool m_baseTablesDirty{true};
+    bool m_tablesDirty{true};
+
+    ChannelTables m_baseTables{};
+    ChannelTables m_tables{};
+
+    std::array<uint32_t, 3> m_channelSums{};
+
+    uint8_t m_frame{};
+};
@@ -0,0 +1,141 @@
+#include "segmenttransition.h"
+
+namespace {
+
+constexpr size_t ProgressSteps = 32;
+
+constexpr size_t SegmentCount = SevenSegmentDigit::LAST_SEGMENT + 1;
+
+constexpr size_t StyleCount = static_cast<size_t>(DigitTransition::Wipe) + 1;
+
+// indexed by (old bit << 1) | new bit
+using SegmentEntry = std::array<uint8_t, 4>;
+
+using StyleTable = std::array<std::array<SegmentEntry, SegmentCount>, ProgressSteps + 1>;
+
+// progress window of a segment in 1/256 of the duration, the segment ramps between begin and end
+struct Window
+{
+    uint16_t begin;
+    uint16_t end;
+};
+
+// top (0) to bottom (4), indexed by Segment
+constexpr std::array<uint8_t, SegmentCount> segmentRows{
+    1, // F
+    2, // G
+    3, // E
+    4, // D
+    3, // C
+    1, // B
+    0, // A
+};
+
+constexpr uint8_t ramp(const uint16_t progress, const Window window)
+{
+    if (progress >= window.end)
+        return 255;
+
+    if (progress <= window.begin)
+        return 0;
+
+    return (progress - window.begin) * 255 / (window.end - window.begin);
+}
+
+constexpr StyleTable buildTable(const DigitTransition style)
+{
+    StyleTable table{};
+
+    for (size_t step = 0; step <= ProgressSteps; ++step)
+    {
+        const uint16_t progress = step * 256 / ProgressSteps;
+
+        for (size_t segment = 0; segment < SegmentCount; ++segment)
+        {
+            Window fadeOut{0, 0};
+            Window fadeIn{0, 0};
+
+            switch (style)
+            {
+            case DigitTransition::Off:
+                break;
+            case DigitTransition::Crossfade:
+                fadeOut = fadeIn = Window{0, 256};
+                break;
+            case DigitTransition::FadeOutIn:
+                fadeOut = Window{0, 128};
+                fadeIn = Window{128, 256};
+                break;
+            case DigitTransition::Wipe:
+                // the change runs down the digit row by row
+                fadeOut = fadeIn = Window{static_cast<uint16_t>(segmentRows[segment] * 32), static_cast<uint16_t>(segmentRows[segment] * 32 + 128)};
+                break;
+            }
+
+            table[step][segment] = SegmentEntry{
+                0,
+                ramp(progress, fadeIn),
+                static_cast<uint8_t>(255 - ramp(progress, fadeOut)),
+                255,
+            };
+        }
+    }
+
+    return table;
+}
+
+constexpr std::array<StyleTable, StyleCount> transitionTable{
+    buildTable(DigitTransition::Off),
+    buildTable(DigitTransition::Crossfade),
+    buildTable(DigitTransition::FadeOutIn),
+    buildTable(DigitTransition::Wipe),
+};
+
+// 0 to 256
+uint16_t progressAt(const espchrono::millis_clock::time_point start, const espchrono::millis_clock::time_point now,
+                    const espchrono::milliseconds32 duration)
+{
+    const auto elapsed = now - start;
+
+    if (duration.count() <= 0 || elapsed >= duration)
+        return 256;
+
+    return elapsed * 256 / duration;
+}
+
+} // namespace
+
+void SegmentTransition::update(const uint8_t mask, const espchrono::millis_clock::time_point now)
+{
+    if (mask == m_to)
+        return;
+
+    // a change in the middle of a transition starts over from the last target
+    m_from = m_to;
+    m_to = mask;
+    m_start = now;
+}
+
+bool SegmentTransition::running(const espchrono::millis_clock::time_point now, const espchrono::milliseconds32 duration) const
+{
+    return m_from != m_to && progressAt(m_start, now, duration) < 256;
+}
+
+SegmentLevels SegmentTransition::levels(const DigitTransition style, const espchrono::millis_clock::time_point now,
+                                        const espchrono::milliseconds32 duration) const
+{
+    const auto& table = transitionTable[static_cast<size_t>(style)];
+    const auto& row = table[progressAt(m_start, now, duration) * ProgressSteps / 256];
+
+    SegmentLevels levels;
+
+    for (size_t segment = 0; segment < SegmentCount; ++segment)
+    {
+        const auto s = static_cast<SevenSegmentDigit::Segment>(segment);
+        const auto index = (SevenSegmentDigit::segmentInMask(m_from, s) << 1) | SevenSegmentDigit::segmentInMask(m_to, s);
+
+        levels[segment] = row[segment][index];
+    }
+
+    return levels;
+}
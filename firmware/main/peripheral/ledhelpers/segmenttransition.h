@@ -0,0 +1,42 @@
+#pragma once
+
+// system includes
+#include <array>
+#include <cstdint>
+
+// 3rdparty lib includes
+#include <cpptypesafeenum.h>
+#include <espchrono.h>
+
+// local includes
+#include "digit.h"
+
+#define DigitTransitionValues(x) \
+    x(Off) \
+    x(Crossfade) \
+    x(FadeOutIn) \
+    x(Wipe)
+DECLARE_GLOBAL_TYPESAFE_ENUM(DigitTransition, : uint8_t, DigitTransitionValues);
+
+// brightness of every segment of a digit, indexed by SevenSegmentDigit::Segment
+using SegmentLevels = std::array<uint8_t, SevenSegmentDigit::LAST_SEGMENT + 1>;
+
+// Moves the segments of one digit from its previous mask to the current one. The levels come
+// from a table built at compile time, indexed by style, progress step, segment and the old and
+// new bit of that segment, so a frame costs seven lookups per digit.
+class SegmentTransition
+{
+public:
+    // feed the digit mask every frame, a new mask starts a transition from the last one
+    void update(uint8_t mask, espchrono::millis_clock::time_point now);
+
+    bool running(espchrono::millis_clock::time_point now, espchrono::milliseconds32 duration) const;
+
+    SegmentLevels levels(DigitTransition style, espchrono::millis_clock::time_point now, espchrono::milliseconds32 duration) const;
+
+private:
+    uint8_t m_from{};
+    uint8_t m_to{};
+
+    espchrono::millis_clock::time_point m_start{};
+};
@@ -3,18 +3,33 @@
 constexpr const char * const TAG = "ledmanager";
 
 // system includes
+#include <algorithm>
 #include <format>
 
+// esp-idf includes
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
 // 3rdparty lib includes
 #include <FastLED.h>
+#include <cleanuphelper.h>
 #include <espchrono.h>
 #include <recursivelockhelper.h>
 
 // local includes
 #include "communication/ota.h"
+#include "communication/realtime.h"
+#include "peripheral/ledhelpers/blend.h"
+#include "peripheral/ledhelpers/compositor.h"
+#include "peripheral/ledhelpers/digithelper.h"
 #include "peripheral/ledhelpers/ledanimation.h"
+#include "peripheral/ledhelpers/ledlayout.h"
+#include "peripheral/ledhelpers/outputstage.h"
 #include "utils/config.h"
 #include "utils/espclock.h"
+#include "utils/renderconfig.h"
+#include "utils/taskplacement.h"
 
 using namespace std::chrono_literals;
 
@@ -25,7 +40,62 @@ cpputils::DelayedConstruction<LedManager> ledManager;
 cpputils::DelayedConstruction<espcpputils::recursive_mutex_semaphore> led_lock;
 
 namespace {
+// animations, digits and dots render into the base layer, the layers are composed into the back buffer
+// and the rmt driver drains the front buffer
+Compositor compositor;
+LedArray& baseLeds = compositor.pixels(CompositorLayer::Base);
 LedArray leds;
+LedArray frontLeds;
+
+// outgoing animation while a transition is running
+LedArray transitionLeds;
+
+// last back buffer seen by trackChanges(), lets clients fetch only what changed
+LedArray previewLeds;
+std::array<uint32_t, HARDWARE_WS2812B_COUNT> changedFrames{};
+uint32_t currentPreviewFrame{};
+
+// bounds for the frame-rate governor, see LedManager::nextFrameInterval()
+constexpr espchrono::milliseconds32 minFrameInterval{8};
+constexpr espchrono::milliseconds32 maxFrameInterval{250};
+constexpr espchrono::milliseconds32 dotBlinkInterval{500};
+constexpr espchrono::milliseconds32 ditherFrameInterval{16};
+constexpr espchrono::milliseconds32 transitionFrameInterval{16};
+
+TaskHandle_t renderTaskHandle{nullptr};
+esp_timer_handle_t frameTimer{nullptr};
+
+RenderStats stats;
+
+// adds the time since start to the histogram of the stage
+void recordStage(const RenderStage stage, const int64_t start)
+{
+    stats.stages[static_cast<size_t>(stage)].record(esp_timer_get_time() - start);
+}
+
+OutputStage outputStage;
+
+// retransmit an unchanged frame from time to time in case a glitch corrupted the strip
+constexpr auto forcedRefreshInterval = 1s;
+
+// FNV-1a over the raw framebuffer plus everything FastLED applies during show()
+uint32_t hashFrame(const LedArray& frame, const uint8_t brightness, const uint32_t milliAmpereLimit)
+{
+    constexpr uint32_t fnvPrime = 16777619u;
+
+    uint32_t hash = 2166136261u;
+
+    const auto* bytes = reinterpret_cast<const uint8_t*>(frame.data());
+    for (size_t i = 0; i < sizeof(LedArray); ++i)
+    {
+        hash = (hash ^ bytes[i]) * fnvPrime;
+    }
+
+    hash = (hash ^ brightness) * fnvPrime;
+    hash = (hash ^ milliAmpereLimit) * fnvPrime;
+
+    return hash;
+}
 
 bool calculateLedVisibility()
 {
@@ -101,31 +171,114 @@ bool isInSecondaryBrightnessTimeRange()
     return false;
 }
 
-bool barrel_jack_connected()
+void frame_timer_callback(void*)
 {
-    // floating when not connected, pull down when connected
-    static bool gpio_initialized = false;
+    xTaskNotifyGive(renderTaskHandle);
+}
 
-    constexpr auto barrel_jack = static_cast<gpio_num_t>(HARDWARE_BARREL_JACK_PIN);
+void trackChanges()
+{
+    const auto frame = currentPreviewFrame + 1;
+    bool changed{};
 
-    if (!gpio_initialized)
+    for (size_t i = 0; i < leds.size(); ++i)
     {
-        // TODO: Test if this actually works
-        gpio_config_t io_conf;
-        io_conf.intr_type = GPIO_INTR_DISABLE;
-        io_conf.mode = GPIO_MODE_INPUT;
-        io_conf.pin_bit_mask = 1ULL << HARDWARE_BARREL_JACK_PIN;
-        io_conf.pull_down_en = GPIO_PULLDOWN_DISABLE;
-        io_conf.pull_up_en = GPIO_PULLUP_ENABLE;
-        if (const auto res = gpio_config(&io_conf); res != ESP_OK)
+        if (leds[i] != previewLeds[i])
         {
-            ESP_LOGE(TAG, "Failed to configure GPIO: %d", res);
-            return false;
+            previewLeds[i] = leds[i];
+            changedFrames[i] = frame;
+            changed = true;
         }
+    }
+
+    if (changed)
+    {
+        currentPreviewFrame = frame;
+    }
+}
+
+// renders the next frame into the back buffer and passes it through the output stage into the front buffer
+void renderFrame()
+{
+    espcpputils::RecursiveLockHelper guard{led_lock->handle};
+
+    renderconfig::refresh();
+
+    ledManager->setVisible(calculateLedVisibility());
+
+    ledManager->render();
+
+    trackChanges();
+
+    auto start = esp_timer_get_time();
+    ledManager->handleVoltageAndCurrent();
+    int64_t powerTime = esp_timer_get_time() - start;
+
+    start = esp_timer_get_time();
+    const auto& config = renderconfig::get();
+    outputStage.setGamma(config.gamma);
+    outputStage.setDithering(config.dithering);
+    outputStage.apply(leds.data(), frontLeds.data(), leds.size());
+    recordStage(RenderStage::Output, start);
+
+    // the estimate and the supply check make up one stage, recorded once per frame
+    start = esp_timer_get_time() - powerTime;
+    ledManager->limitPower(outputStage.channelSums());
+    recordStage(RenderStage::Power, start);
+}
+
+void scheduleNextFrame(const std::chrono::microseconds delay)
+{
+    // a frame requested via requestFrame() may have rendered before the timer fired
+    esp_timer_stop(frameTimer);
+
+    if (const auto res = esp_timer_start_once(frameTimer, std::max(delay, std::chrono::microseconds{0}).count()); res != ESP_OK)
+    {
+        ESP_LOGE(TAG, "esp_timer_start_once() failed: %s", esp_err_to_name(res));
+    }
+}
+
+[[noreturn]] void render_task(void*)
+{
+    auto helper = cpputils::makeCleanupHelper([](){ vTaskDelete(nullptr); });
+
+    while (true)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        scheduleNextFrame(runFrame());
+    }
+}
+
+constexpr auto barrel_jack = static_cast<gpio_num_t>(HARDWARE_BARREL_JACK_PIN);
 
-        gpio_initialized = true;
+// the supply does not change by the frame
+constexpr auto barrelJackCheckInterval = 1s;
+
+// WS2812B current draw at full channel value, same model FastLED's power limiter uses
+constexpr uint32_t redMilliAmpere = 16;
+constexpr uint32_t greenMilliAmpere = 11;
+constexpr uint32_t blueMilliAmpere = 15;
+constexpr uint32_t idleMilliAmpere = 1;
+
+void init_barrel_jack()
+{
+    // floating when not connected, pull down when connected
+    // TODO: Test if this actually works
+    gpio_config_t io_conf;
+    io_conf.intr_type = GPIO_INTR_DISABLE;
+    io_conf.mode = GPIO_MODE_INPUT;
+    io_conf.pin_bit_mask = 1ULL << HARDWARE_BARREL_JACK_PIN;
+    io_conf.pull_down_en = GPIO_PULLDOWN_DISABLE;
+    io_conf.pull_up_en = GPIO_PULLUP_ENABLE;
+    if (const auto res = gpio_config(&io_conf); res != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to configure GPIO: %d", res);
     }
+}
 
+bool barrel_jack_connected()
+{
     return gpio_get_level(barrel_jack) == 0;
 }
 
@@ -133,14 +286,17 @@ bool barrel_jack_connected()
 
 void LedManager::handleVoltageAndCurrent()
 {
+    const auto& config = renderconfig::get();
+
     // const auto now = espchrono::millis_clock::now();
-    const auto brightness = configs.ledBrightness.value();
-    const auto secondaryBrightness = configs.ledSecondaryBrightness.value();
+    const auto brightness = config.brightness;
+    const auto secondaryBrightness = config.secondaryBrightness;
     const auto inSecondaryBrightnessTimeRange = isInSecondaryBrightnessTimeRange();
 
     ESP_LOGD(TAG, "brightness: %d, secondaryBrightness: %d, inSecondaryBrightnessTimeRange: %d", brightness, secondaryBrightness, inSecondaryBrightnessTimeRange);
 
     const uint8_t brightnessTarget = !m_visible ? 0 : inSecondaryBrightnessTimeRange ? secondaryBrightness : brightness;
+    m_brightnessTarget = brightnessTarget;
 
     constexpr float fadeFactor = 0.9f;
     m_brightness = m_brightness * fadeFactor + brightnessTarget * (1.0f - fadeFactor);
@@ -151,168 +307,592 @@ void LedManager::handleVoltageAndCurrent()
         m_brightness = brightnessTarget;
     }
 
-    FastLED.setBrightness(m_brightness);
+    outputStage.setBrightness(m_brightness);
+
+    if (const auto now = espchrono::millis_clock::now(); now - m_barrelJackLastCheck >= barrelJackCheckInterval)
+    {
+        m_barrelJackConnected = barrel_jack_connected();
+        m_barrelJackLastCheck = now;
+    }
 
-    if (barrel_jack_connected())
+    if (m_barrelJackConnected)
     {
         // increase current
         // 5V, 8A
-        FastLED.setMaxPowerInVoltsAndMilliamps(5, configs.ledMilliAmpereBarrelJack.value());
+        m_milliAmpereLimit = config.milliAmpereBarrelJack;
     }
     else
     {
         // 5V, 3A
-        FastLED.setMaxPowerInVoltsAndMilliamps(5, configs.ledMilliAmpereUsbC.value());
+        m_milliAmpereLimit = config.milliAmpereUsbC;
+    }
+}
+
+void LedManager::limitPower(const std::array<uint32_t, 3>& channelSums)
+{
+    const auto& [red, green, blue] = channelSums;
+
+    const uint32_t idle = idleMilliAmpere * HARDWARE_WS2812B_COUNT;
+    const uint32_t active = (red * redMilliAmpere + green * greenMilliAmpere + blue * blueMilliAmpere) / 255;
+
+    uint8_t scale = 255;
+
+    if (idle + active > m_milliAmpereLimit && active > 0)
+    {
+        const uint32_t available = m_milliAmpereLimit > idle ? m_milliAmpereLimit - idle : 0;
+        scale = std::min<uint32_t>(255, available * 255 / active);
     }
+
+    m_powerScale = scale;
+    m_currentMilliAmpere = idle + active * scale / 255;
+
+    // FastLED scales the pixels while transmitting anyway, so the limit costs no extra pass
+    FastLED.setBrightness(scale);
 }
 
 void begin()
 {
     led_lock.construct();
 
-    FastLED.addLeds<WS2812B, HARDWARE_WS2812B_PIN, HARDWARE_WS2812B_COLOR_ORDER>(leds.data(), leds.size());
+    init_barrel_jack();
+
+    FastLED.addLeds<WS2812B, HARDWARE_WS2812B_PIN, HARDWARE_WS2812B_COLOR_ORDER>(frontLeds.data(), frontLeds.size());
 
-    FastLED.setCorrection(TypicalSMD5050);
+    // brightness, correction and dithering are handled by the output stage,
+    // FastLED's brightness only carries the power limit
+    FastLED.setBrightness(255);
+
+    FastLED.setCorrection(UncorrectedColor);
 
     FastLED.setDither(0);
 
+    outputStage.setCorrection(CRGB{TypicalSMD5050});
+
     FastLED.clear();
 
-    // Digit 1: LED_1 -> LED_56 => start 0, length 56
-    // Digit 2: LED_57 -> LED_112 => start 56, length 56
-    // Upper Dot: LED_113 -> LED_116 => start 112, length 4
-    // Lower Dot: LED_117 -> LED_120 => start 116, length 4
-    // Digit 3: LED_121 -> LED_176 => start 120, length 56
-    // Digit 4: LED_177 -> LED_232 => start 176, length 56
+    using ledlayout::layout;
+    using ledlayout::segmentOffsets;
 
     ledManager.construct(LedManager{
         {
-            SevenSegmentDigit{leds.data() + 0, 56},
-            SevenSegmentDigit{leds.data() + 56, 56},
-            SevenSegmentDigit{leds.data() + 120, 56},
-            SevenSegmentDigit{leds.data() + 176, 56},
+            SevenSegmentDigit{baseLeds.data() + layout.digitOffsets[0], layout.digitLength, segmentOffsets, layout.ledsPerSegment},
+            SevenSegmentDigit{baseLeds.data() + layout.digitOffsets[1], layout.digitLength, segmentOffsets, layout.ledsPerSegment},
+            SevenSegmentDigit{baseLeds.data() + layout.digitOffsets[2], layout.digitLength, segmentOffsets, layout.ledsPerSegment},
+            SevenSegmentDigit{baseLeds.data() + layout.digitOffsets[3], layout.digitLength, segmentOffsets, layout.ledsPerSegment},
         },
-        ClockDot{ClockDot::Top, leds.data() + 112, 4},
-        ClockDot{ClockDot::Bottom, leds.data() + 116, 4},
+        ClockDot{ClockDot::Top, baseLeds.data() + layout.dotOffsets[0], layout.dotLength},
+        ClockDot{ClockDot::Bottom, baseLeds.data() + layout.dotOffsets[1], layout.dotLength},
     });
 
     for (auto& digit : ledManager->digits)
     {
         digit.setChar('1');
     }
+
+    compositor.setBlendMode(CompositorLayer::Digits, BlendMode::Multiply);
+    compositor.setBlendMode(CompositorLayer::Notification, BlendMode::Add);
+    compositor.setOpacity(CompositorLayer::Notification, 0);
+    compositor.setOpacity(CompositorLayer::System, 0);
+
+    if (const auto result = taskplacement::createTask(render_task, "ledRender", nullptr, &renderTaskHandle); result != pdPASS)
+    {
+        ESP_LOGE(TAG, "failed creating render task %d", result);
+        return;
+    }
+
+    // render right away when brightness, colors or the override text change
+    renderconfig::notifyOnChange(renderTaskHandle);
+
+    const esp_timer_create_args_t timerArgs{
+        .callback = frame_timer_callback,
+        .arg = nullptr,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "ledFrame",
+        // one shot, there are no periodic events to skip
+        .skip_unhandled_events = false,
+    };
+
+    if (const auto res = esp_timer_create(&timerArgs, &frameTimer); res != ESP_OK)
+    {
+        ESP_LOGE(TAG, "esp_timer_create() failed: %s", esp_err_to_name(res));
+        return;
+    }
+
+    scheduleNextFrame(minFrameInterval);
+}
+
+void requestFrame()
+{
+    if (renderTaskHandle)
+    {
+        xTaskNotifyGive(renderTaskHandle);
+    }
 }
 
-void update()
+std::chrono::microseconds runFrame()
 {
+    const auto start = esp_timer_get_time();
+    const auto frameStart = espchrono::millis_clock::now();
+
+    renderFrame();
+
+    const auto showStart = esp_timer_get_time();
+
+    // the back buffer is free again, the next frame can be rendered while the front buffer is sent out
+    ledManager->show();
+
+    const auto end = esp_timer_get_time();
+    const std::chrono::microseconds frameTime{end - start};
+
+    // the stats are copied under led_lock by the api, mqtt and the status
     espcpputils::RecursiveLockHelper guard{led_lock->handle};
 
-    /*
-    if (ota::isInProgress()) // Prevent guru meditation error because of rmt inline not in IRAM
-        return;
-    */
+    stats.stages[static_cast<size_t>(RenderStage::Frame)].record(showStart - start);
+    stats.stages[static_cast<size_t>(RenderStage::Show)].record(end - showStart);
+
+    realtime::frameShown();
+
+    const std::chrono::microseconds frameInterval{ledManager->nextFrameInterval(frameStart)};
 
-    if (ledManager.constructed())
+    ++stats.frames;
+    stats.lastFrameTime = frameTime;
+    stats.maxFrameTime = std::max(stats.maxFrameTime, frameTime);
+    stats.averageFrameTime = (stats.averageFrameTime * 15 + frameTime) / 16;
+    stats.frameInterval = frameInterval;
+
+    if (frameTime > frameInterval)
     {
-        ledManager->setVisible(calculateLedVisibility());
+        ++stats.missedDeadlines;
+    }
 
-        ledManager->render();
+    return frameInterval - frameTime;
+}
 
-        ledManager->handleVoltageAndCurrent();
+void LedManager::show()
+{
+    // the strip keeps its state, only transmit when the output would actually change
+    const auto frameHash = hashFrame(frontLeds, FastLED.getBrightness(), m_milliAmpereLimit);
+    const auto now = espchrono::millis_clock::now();
 
-        FastLED.show();
+    if (m_lastFrameHash && *m_lastFrameHash == frameHash && now - m_lastShow < forcedRefreshInterval)
+    {
+        ++m_skippedFrames;
+        return;
     }
+
+    m_lastFrameHash = frameHash;
+    m_lastShow = now;
+
+    FastLED.show();
 }
 
 void LedManager::render()
 {
     const auto now = espchrono::millis_clock::now();
 
-    m_lastDotsOn = m_dotsOn;
-    m_dotsOn = configs.disableDotBlinking.value() || now.time_since_epoch() % 1s < 500ms;
+    const auto& config = renderconfig::get();
+
+    m_dotsOn = config.disableDotBlinking || now.time_since_epoch() % 1s < 500ms;
 
     upper_dot.on(m_dotsOn);
     lower_dot.on(m_dotsOn);
 
-    const auto overrideTimeoutConfig = configs.ledOverrideDigitsTimeout.value();
+    const auto overrideTimeoutConfig = config.overrideDigitsTimeout;
 
     if (overrideTimeoutConfig && m_overrideTriggeredAt)
     {
         if (espchrono::ago(*m_overrideTriggeredAt) > espchrono::milliseconds32{overrideTimeoutConfig})
         {
-            configs.write_config(configs.ledOverrideDigits, "");
+            configutils::write_config(configs.ledOverrideDigits, "");
             m_overrideTriggeredAt.reset();
         }
     }
 
-    if (const auto res = animation::updateAnimation(configs.ledAnimation.value(), leds); !res)
+    // realtime packets own the back buffer, the layers are composed again once they stop
+    if (realtime::active())
     {
-        ESP_LOGE(TAG, "Failed to update animation: %.*s\n", res.error().size(), res.error().data());
+        m_baseStale = true;
+        compositor.invalidate();
+        return;
     }
-    else if (const auto currentAnimation = animation::currentAnimation; currentAnimation)
+
+    // the override text only changes with the config, apply it once per snapshot
+    if (config.overrideDigitsActive && config.generation != m_overrideGeneration)
     {
-        if (currentAnimation->needsUpdate() || m_lastDotsOn != m_dotsOn)
+        m_overrideGeneration = config.generation;
+
+        const auto textChanged = setText(config.overrideDigits);
+
+        if (overrideTimeoutConfig && textChanged)
         {
-            const auto start_update = espchrono::millis_clock::now();
+            m_overrideTriggeredAt = now;
+        }
+    }
 
-            if (const auto& val = configs.ledOverrideDigits.value(); !val.empty())
-            {
-                const auto textChanged = ledManager->setText(val);
+    if (!config.overrideDigitsActive)
+    {
+        m_marquee.stop();
+    }
+    else if (m_marquee.active())
+    {
+        std::array<uint8_t, std::tuple_size_v<Digits>> masks;
 
-                if (overrideTimeoutConfig && textChanged)
-                {
-                    m_overrideTriggeredAt = now;
-                }
+        if (m_marquee.window(now, espchrono::milliseconds32{config.marqueeStepMs}, config.marqueeLoops, masks))
+        {
+            for (size_t i = 0; i < digits.size(); ++i)
+            {
+                digits[i].setMask(masks[i]);
             }
+        }
+        else
+        {
+            // every pass has been shown, the clock takes over again
+            m_marquee.stop();
+            configutils::write_config(configs.ledOverrideDigits, "");
+            m_overrideTriggeredAt.reset();
+        }
+    }
+
+    renderSystemLayer();
 
-            // Only update the current animation when the render is not triggered by the dots changing
-            if (m_lastDotsOn == m_dotsOn)
+    renderNotificationLayer(now);
+
+    auto start = esp_timer_get_time();
+    if (renderDigitsLayer(now))
+    {
+        // animations may paint by digit content, the blinking dots are masked out without repainting
+        m_baseStale = true;
+    }
+    recordStage(RenderStage::Mask, start);
+
+    // nobody sees the animation behind the ota progress
+    if (compositor.covered(CompositorLayer::Base))
+    {
+        m_baseStale = true;
+    }
+    else
+    {
+        renderBaseLayer();
+    }
+
+    start = esp_timer_get_time();
+    if (compositor.compose(leds.data()))
+    {
+        recordStage(RenderStage::Compose, start);
+    }
+}
+
+void LedManager::renderBaseLayer()
+{
+    const auto& config = renderconfig::get();
+    const auto lastAnimation = animation::currentAnimation;
+
+    if (const auto res = animation::updateAnimation(configs.ledAnimation.value(), baseLeds); !res)
+    {
+        ESP_LOGE(TAG, "Failed to update animation: %.*s\n", res.error().size(), res.error().data());
+        return;
+    }
+
+    const auto currentAnimation = animation::currentAnimation;
+    if (!currentAnimation)
+    {
+        return;
+    }
+
+    const auto previousAnimation = animation::previousAnimation;
+    const auto needsUpdate = currentAnimation->needsUpdate();
+
+    // a new animation or new colors show up right away instead of with the next update
+    const auto stale = std::exchange(m_baseStale, false) || currentAnimation != lastAnimation || config.generation != m_baseGeneration;
+    m_baseGeneration = config.generation;
+
+    // digits and dots blank on their own layer, the animation keeps its pixels in between
+    if (!stale && !previousAnimation && !needsUpdate)
+    {
+        return;
+    }
+
+    const auto renderStart = esp_timer_get_time();
+
+    // both animations add up during a transition, Render gets the rest of this block
+    int64_t updateTime{};
+    bool updated{};
+
+    // both animations render every frame while a transition is running
+    if (previousAnimation)
+    {
+        if (previousAnimation->needsUpdate())
+        {
+            const auto start = esp_timer_get_time();
+            previousAnimation->update();
+            updateTime += esp_timer_get_time() - start;
+            updated = true;
+        }
+
+        renderAnimation(*previousAnimation);
+
+        transitionLeds = baseLeds;
+    }
+
+    if (needsUpdate)
+    {
+        const auto start = esp_timer_get_time();
+        currentAnimation->update();
+        updateTime += esp_timer_get_time() - start;
+        updated = true;
+    }
+
+    renderAnimation(*currentAnimation);
+
+    if (previousAnimation)
+    {
+        const auto progress = animation::transitionProgress();
+
+        blendLeds(transitionLeds.data(), baseLeds.data(), baseLeds.data(), baseLeds.size(), progress);
+
+        if (progress >= 256)
+        {
+            animation::finishTransition(baseLeds);
+        }
+    }
+
+    compositor.markDirty(CompositorLayer::Base);
+
+    if (updated)
+    {
+        stats.stages[static_cast<size_t>(RenderStage::AnimationUpdate)].record(updateTime);
+    }
+
+    recordStage(RenderStage::Render, renderStart + updateTime);
+}
+
+bool LedManager::renderDigitsLayer(const espchrono::millis_clock::time_point now)
+{
+    const auto& config = renderconfig::get();
+    const auto transitionDuration = digitTransitionDuration();
+
+    // everything that decides the mask, one bit per segment and dot
+    uint32_t state = (upper_dot.visible() ? 1u : 0u) | (lower_dot.visible() ? 2u : 0u);
+    bool transitioning{};
+
+    for (size_t i = 0; i < digits.size(); ++i)
+    {
+        // all segments pass the animation through without clock digits
+        const uint8_t mask = config.noClockDigits ? 0x7f : digits[i].mask();
+
+        state |= uint32_t{mask} << (2 + i * 7);
+
+        m_segmentTransitions[i].update(mask, now);
+        transitioning |= m_segmentTransitions[i].running(now, transitionDuration);
+    }
+
+    const auto changed = m_digitsState != state;
+
+    // the dots sit in the two low bits and blink every 500ms, the animation only cares about the digits
+    const auto digitsChanged = !m_digitsState || (*m_digitsState >> 2) != (state >> 2);
+
+    // the last transition frame has to land on the final levels as well
+    if (!changed && !transitioning && !std::exchange(m_digitsTransitioning, false))
+    {
+        return false;
+    }
+
+    m_digitsState = state;
+    m_digitsTransitioning = transitioning;
+
+    auto& mask = compositor.pixels(CompositorLayer::Digits);
+
+    const auto offsetOf = [](const CRGB* led) { return led - baseLeds.data(); };
+
+    // leds outside of digits and dots pass through
+    std::ranges::fill(mask, CRGB::White);
+
+    for (size_t i = 0; i < digits.size(); ++i)
+    {
+        const auto levels = m_segmentTransitions[i].levels(config.digitTransition, now, transitionDuration);
+
+        for (const auto& span : digits[i].segments())
+        {
+            const auto level = levels[span.segment];
+            std::fill_n(mask.begin() + offsetOf(span.begin), span.length(), CRGB{level, level, level});
+        }
+    }
+
+    for (const auto* dot : {&upper_dot, &lower_dot})
+    {
+        std::fill_n(mask.begin() + offsetOf(dot->begin()), dot->length(), dot->visible() ? CRGB::White : CRGB::Black);
+    }
+
+    compositor.markDirty(CompositorLayer::Digits);
+
+    return digitsChanged;
+}
+
+espchrono::milliseconds32 LedManager::digitTransitionDuration() const
+{
+    const auto& config = renderconfig::get();
+
+    if (config.digitTransition == DigitTransition::Off)
+    {
+        return espchrono::milliseconds32{0};
+    }
+
+    return espchrono::milliseconds32{static_cast<int32_t>(config.digitTransitionMs)};
+}
+
+void LedManager::notify(const CRGB& color, const espchrono::milliseconds32 duration)
+{
+    std::ranges::fill(compositor.pixels(CompositorLayer::Notification), color);
+    compositor.markDirty(CompositorLayer::Notification);
+
+    m_notification = Notification{
+        .start = espchrono::millis_clock::now(),
+        .duration = duration,
+    };
+
+    requestFrame();
+}
+
+void LedManager::renderNotificationLayer(const espchrono::millis_clock::time_point now)
+{
+    uint8_t opacity{};
+
+    if (m_notification)
+    {
+        const auto elapsed = now - m_notification->start;
+
+        if (m_notification->duration.count() <= 0 || elapsed >= m_notification->duration)
+        {
+            m_notification.reset();
+        }
+        else
+        {
+            // fades out linearly
+            opacity = 255 - elapsed * 255 / m_notification->duration;
+        }
+    }
+
+    compositor.setOpacity(CompositorLayer::Notification, opacity);
+}
+
+void LedManager::renderSystemLayer()
+{
+    if (!ota::isInProgress())
+    {
+        m_systemPercent.reset();
+        compositor.setOpacity(CompositorLayer::System, 0);
+        return;
+    }
+
+    compositor.setOpacity(CompositorLayer::System, 255);
+
+    const auto percent = static_cast<uint8_t>(std::clamp(ota::percent(), 0.f, 100.f));
+
+    if (m_systemPercent == percent)
+    {
+        return;
+    }
+
+    m_systemPercent = percent;
+
+    // right aligned percentage on the last three digits in green, dots off
+    const std::array<uint8_t, 3> places{
+        static_cast<uint8_t>(percent / 100),
+        static_cast<uint8_t>((percent / 10) % 10),
+        static_cast<uint8_t>(percent % 10),
+    };
+    const size_t placeCount = percent == 100 ? 3 : percent >= 10 ? 2 : 1;
+
+    auto& pixels = compositor.pixels(CompositorLayer::System);
+
+    std::ranges::fill(pixels, CRGB::Black);
+
+    for (size_t i = 1; i < digits.size(); ++i)
+    {
+        if (i < digits.size() - placeCount)
+        {
+            continue;
+        }
+
+        const auto digitMask = digithelper::getSegmentMask('0' + places[i - 1]);
+
+        for (const auto& span : digits[i].segments())
+        {
+            if (SevenSegmentDigit::segmentInMask(digitMask, span.segment))
             {
-                currentAnimation->update();
+                std::fill_n(pixels.begin() + (span.begin - baseLeds.data()), span.length(), CRGB::Green);
             }
+        }
+    }
 
-            switch (currentAnimation->renderType())
+    compositor.markDirty(CompositorLayer::System);
+}
+
+void LedManager::renderAnimation(animation::LedAnimation& animation)
+{
+    switch (animation.renderType())
+    {
+        case animation::ForEverySegment: {
+            animation.render_segments(digits);
+            break;
+        }
+        case animation::AllAtOnce: {
+            animation.render_all(baseLeds.begin(), baseLeds.size());
+            break;
+        }
+        case animation::ForEveryDigit: {
+            for (auto &digit: digits)
             {
-                case animation::ForEverySegment: {
-                    for (auto &digit: digits)
-                    {
-                        digit.forEverySegment([&](const SevenSegmentDigit::Segment segment, CRGB *startLed, CRGB *endLed,
-                                                  const size_t length) {
-                            currentAnimation->render_segment(segment, digit, startLed, endLed, length);
-                        });
-                    }
-                    break;
-                }
-                case animation::AllAtOnce: {
-                    currentAnimation->render_all(leds.begin(), leds.size());
-                    break;
-                }
-                case animation::ForEveryDigit: {
-                    for (auto &digit: digits)
-                    {
-                        currentAnimation->render_digit(digit, &digit - &digits[0], leds.begin(), leds.size());
-                    }
-                    break;
-                }
+                animation.render_digit(digit, &digit - &digits[0], baseLeds.begin(), baseLeds.size());
             }
+            break;
+        }
+    }
 
-            currentAnimation->render_dot(upper_dot, leds.begin(), leds.size());
-            currentAnimation->render_dot(lower_dot, leds.begin(), leds.size());
+    animation.render_dot(upper_dot, baseLeds.begin(), baseLeds.size());
+    animation.render_dot(lower_dot, baseLeds.begin(), baseLeds.size());
+}
 
-            const auto diffMs = espchrono::ago(start_update) / 1ms;
-            ESP_LOGI(TAG, "Updating animation took %lldms", diffMs);
-        }
+espchrono::milliseconds32 LedManager::nextFrameInterval(const espchrono::millis_clock::time_point frameStart) const
+{
+    // brightness fades are applied per frame, keep them smooth
+    if (m_brightness != m_brightnessTarget)
+    {
+        return minFrameInterval;
     }
 
-    upper_dot.render();
-    lower_dot.render();
+    auto interval = maxFrameInterval;
 
-    if (!configs.noClockDigits.value())
+    // temporal dithering only works when frames keep coming
+    if (outputStage.dithering() && m_brightness > 0)
     {
-        for (auto &digit: digits)
-        {
-            digit.renderMask();
-        }
+        interval = ditherFrameInterval;
+    }
+
+    if (animation::previousAnimation || m_notification || m_digitsTransitioning)
+    {
+        interval = std::min(interval, transitionFrameInterval);
+    }
+
+    if (const auto currentAnimation = animation::currentAnimation; currentAnimation && m_visible)
+    {
+        const auto animationInterval = currentAnimation->getFrameInterval() / renderconfig::get().animationMultiplier;
+        interval = std::min(interval, espchrono::milliseconds32{static_cast<int32_t>(animationInterval.count())});
     }
+
+    if (m_marquee.active())
+    {
+        interval = std::min(interval, m_marquee.untilNextStep(frameStart, espchrono::milliseconds32{renderconfig::get().marqueeStepMs}));
+    }
+
+    // wake up right at the next blink edge instead of polling for it
+    if (!renderconfig::get().disableDotBlinking)
+    {
+        const auto sinceEdge = frameStart.time_since_epoch() % dotBlinkInterval;
+        interval = std::min(interval, espchrono::milliseconds32{dotBlinkInterval - sinceEdge});
+    }
+
+    return std::clamp(interval, minFrameInterval, maxFrameInterval);
 }
 
 std::string LedManager::toString() const
@@ -333,6 +913,14 @@ uint16_t LedManager::getFps()
 
 bool LedManager::setText(const std::string_view text)
 {
+    // render() moves the window through the digits
+    if (text.size() > digits.size())
+    {
+        return m_marquee.start(text, digits.size(), espchrono::millis_clock::now());
+    }
+
+    m_marquee.stop();
+
     bool changed = false;
 
     for (size_t i = 0; i < digits.size(); ++i)
@@ -370,4 +958,24 @@ const std::array<CRGB, HARDWARE_WS2812B_COUNT>& getLeds()
     return leds;
 }
 
+LedArray& mutableLeds()
+{
+    return leds;
+}
+
+uint32_t previewFrame()
+{
+    return currentPreviewFrame;
+}
+
+const std::array<uint32_t, HARDWARE_WS2812B_COUNT>& ledChangedFrames()
+{
+    return changedFrames;
+}
+
+const RenderStats& renderStats()
+{
+    return stats;
+}
+
 } // namespace ledmanager
@@ -2,6 +2,7 @@
 
 // system includes
 #include <array>
+#include <chrono>
 #include <string>
 #include <utility>
 
@@ -14,6 +15,9 @@
 // local includes
 #include "ledhelpers/digit.h"
 #include "ledhelpers/clockdot.h"
+#include "ledhelpers/marquee.h"
+#include "ledhelpers/segmenttransition.h"
+#include "utils/histogram.h"
 
 #define SecondaryBrightnessModeValues(x) \
     x(Off) \
@@ -21,10 +25,41 @@
     x(UseSunriseSunset)
 DECLARE_GLOBAL_TYPESAFE_ENUM(SecondaryBrightnessMode, : uint8_t, SecondaryBrightnessModeValues);
 
+#define RenderStageValues(x) \
+    x(AnimationUpdate) \
+    x(Render) \
+    x(Mask) \
+    x(Compose) \
+    x(Power) \
+    x(Output) \
+    x(Show) \
+    x(Frame)
+DECLARE_GLOBAL_TYPESAFE_ENUM(RenderStage, : uint8_t, RenderStageValues);
+
+#define RENDER_STAGE_COUNT(name) + 1
+constexpr size_t RenderStageCount = 0 RenderStageValues(RENDER_STAGE_COUNT);
+#undef RENDER_STAGE_COUNT
+
+namespace animation {
+class LedAnimation;
+} // namespace animation
+
 namespace ledmanager {
 
 using LedArray = std::array<CRGB, HARDWARE_WS2812B_COUNT>;
 
+struct RenderStats
+{
+    uint32_t frames{};
+    uint32_t missedDeadlines{};
+    std::chrono::microseconds lastFrameTime{};
+    std::chrono::microseconds maxFrameTime{};
+    std::chrono::microseconds averageFrameTime{};
+    std::chrono::microseconds frameInterval{};
+    // time spent per pipeline stage in microseconds, Frame covers the whole frame without show()
+    std::array<Histogram, RenderStageCount> stages{};
+};
+
 class LedManager
 {
     using Digits = std::array<SevenSegmentDigit, 4>;
@@ -38,43 +73,132 @@ public:
     ClockDot upper_dot;
     ClockDot lower_dot;
 
+    // renders the dirty layers and composes them into the led array, does not touch any hardware
     void render();
 
+    // flashes color over the clock and fades it out over duration, take led_lock
+    void notify(const CRGB& color, espchrono::milliseconds32 duration);
+
+    // pushes the output frame to the strip
+    void show();
+
     void setVisible(const bool visible) { m_visible = visible; }
 
     void handleVoltageAndCurrent();
 
+    // estimates the strip current of the output frame and scales it down to the supply limit
+    void limitPower(const std::array<uint32_t, 3>& channelSums);
+
+    uint32_t getCurrentMilliAmpere() const { return m_currentMilliAmpere; }
+
+    uint32_t getMilliAmpereLimit() const { return m_milliAmpereLimit; }
+
+    uint8_t getPowerScale() const { return m_powerScale; }
+
     static uint16_t getFps();
 
     float getBrightness() const { return m_brightness; }
 
     bool isVisible() const { return m_visible && m_brightness > 0; }
 
+    uint32_t getSkippedFrames() const { return m_skippedFrames; }
+
+    // output frame interval chosen from the animation, brightness fade and dot blinking,
+    // counted from frameStart so the caller can subtract the time the frame took
+    espchrono::milliseconds32 nextFrameInterval(espchrono::millis_clock::time_point frameStart) const;
+
+    // texts longer than the digits scroll through them, see Marquee
     bool setText(std::string_view text);
 
 private:
 
     std::string toString() const;
 
+    void renderAnimation(animation::LedAnimation& animation);
+
+    // animations and their transitions
+    void renderBaseLayer();
+
+    // multiply mask that blanks unlit segments and dots, returns whether a digit mask changed,
+    // dot changes only update the mask
+    bool renderDigitsLayer(espchrono::millis_clock::time_point now);
+
+    // 0 while transitions are off
+    espchrono::milliseconds32 digitTransitionDuration() const;
+
+    void renderNotificationLayer(espchrono::millis_clock::time_point now);
+
+    // ota progress, covers everything below while an update is running
+    void renderSystemLayer();
+
     bool m_visible{};
 
     bool m_dotsOn{};
-    bool m_lastDotsOn{};
+
+    // the base layer was covered or overwritten by realtime packets and has to be repainted
+    bool m_baseStale{};
+    uint32_t m_baseGeneration{};
+
+    std::optional<uint32_t> m_digitsState{};
+
+    std::array<SegmentTransition, std::tuple_size_v<Digits>> m_segmentTransitions{};
+    bool m_digitsTransitioning{};
+
+    std::optional<uint8_t> m_systemPercent{};
+
+    struct Notification
+    {
+        espchrono::millis_clock::time_point start;
+        espchrono::milliseconds32 duration;
+    };
+    std::optional<Notification> m_notification{};
 
     float m_brightness{0};
+    uint8_t m_brightnessTarget{0};
     espchrono::millis_clock::time_point m_brightnessLastUpdate{};
 
     std::optional<espchrono::millis_clock::time_point> m_overrideTriggeredAt{};
+    uint32_t m_overrideGeneration{};
+
+    Marquee m_marquee;
+
+    uint32_t m_milliAmpereLimit{};
+    uint32_t m_currentMilliAmpere{};
+    uint8_t m_powerScale{255};
+
+    bool m_barrelJackConnected{};
+    espchrono::millis_clock::time_point m_barrelJackLastCheck{};
+
+    std::optional<uint32_t> m_lastFrameHash{};
+    espchrono::millis_clock::time_point m_lastShow{};
+    uint32_t m_skippedFrames{};
 };
 
 extern cpputils::DelayedConstruction<LedManager> ledManager;
 
 extern cpputils::DelayedConstruction<espcpputils::recursive_mutex_semaphore> led_lock;
 
+// sets up the strip and starts the pinned render task
 void begin();
 
-void update();
-
 const LedArray& getLeds();
 
+// the back buffer for realtime ingress, which writes pixels without the animations, take led_lock
+LedArray& mutableLeds();
+
+// counts rendered frames in which at least one led changed, take led_lock
+uint32_t previewFrame();
+
+// preview frame in which each led last changed, take led_lock
+const std::array<uint32_t, HARDWARE_WS2812B_COUNT>& ledChangedFrames();
+
+// take led_lock
+const RenderStats& renderStats();
+
+// renders a frame as soon as possible instead of waiting for the governor
+void requestFrame();
+
+// renders, shows and accounts one frame like the render task, returns the delay until the next one is due
+std::chrono::microseconds runFrame();
+
 } // namespace ledmanager
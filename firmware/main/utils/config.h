@@ -6,6 +6,7 @@
 #include <array>
 #include <optional>
 #include <string>
+#include <utility>
 
 // esp-idf includes
 #include <esp_sntp.h>
@@ -20,6 +21,7 @@
 #include <espwifistack.h>
 
 // local includes
+#include "peripheral/ledhelpers/effectvm.h"
 #include "peripheral/ledhelpers/ledanimation.h"
 
 using namespace espconfig;
@@ -366,6 +368,65 @@ public:
         value_t defaultValue() const final { return 0; }
         ConfigConstraintReturnType checkValue(value_t value) const final { return {}; }
     } ledOverrideDigitsTimeout;
+    // override text longer than the digits scrolls through them
+    struct : ConfigWrapper<milliseconds32>
+    {
+        bool allowReset() const final { return true; }
+        const char* nvsName() const final { return "marqueeStep"; }
+        value_t defaultValue() const final { return milliseconds32{300}; }
+        ConfigConstraintReturnType checkValue(value_t value) const final {
+            if (value < milliseconds32{20}) {
+                return std::unexpected("Value must be at least 20ms");
+            }
+            return {};
+        }
+    } marqueeStepInterval;
+    struct : ConfigWrapper<uint8_t>
+    {
+        bool allowReset() const final { return true; }
+        const char* nvsName() const final { return "marqueeLoops"; }
+        value_t defaultValue() const final { return 0; }
+        ConfigConstraintReturnType checkValue(value_t value) const final { return {}; }
+    } marqueeLoops;
+    // how the segments change when a digit does
+    struct : ConfigWrapper<DigitTransition>
+    {
+        bool allowReset() const final { return true; }
+        const char* nvsName() const final { return "digitTransition"; }
+        value_t defaultValue() const final { return DigitTransition::Crossfade; }
+        ConfigConstraintReturnType checkValue(value_t value) const final { return {}; }
+    } digitTransition;
+    struct : ConfigWrapper<milliseconds32>
+    {
+        bool allowReset() const final { return true; }
+        const char* nvsName() const final { return "digitTransTime"; }
+        value_t defaultValue() const final { return milliseconds32{250}; }
+        ConfigConstraintReturnType checkValue(value_t value) const final {
+            if (value < milliseconds32{0} || value > milliseconds32{2000}) {
+                return std::unexpected("Value must be between 0 and 2000ms");
+            }
+            return {};
+        }
+    } digitTransitionDuration;
+    struct : ConfigWrapper<float>
+    {
+        bool allowReset() const final { return true; }
+        const char* nvsName() const final { return "ledGamma"; }
+        value_t defaultValue() const final { return 1; }
+        ConfigConstraintReturnType checkValue(value_t value) const final {
+            if (value < 0.1f || value > 4.f) {
+                return std::unexpected("Value must be between 0.1 and 4");
+            }
+            return {};
+        }
+    } ledGamma;
+    struct : ConfigWrapper<bool>
+    {
+        bool allowReset() const final { return true; }
+        const char* nvsName() const final { return "ledDithering"; }
+        value_t defaultValue() const final { return false; }
+        ConfigConstraintReturnType checkValue(value_t value) const final { return {}; }
+    } ledDithering;
 
     // Time
     struct : ConfigWrapper<minutes32>
@@ -465,6 +526,36 @@ public:
         value_t defaultValue() const final { return milliseconds32{60000}; } // 1 minute
         ConfigConstraintReturnType checkValue(value_t value) const final { return {}; }
     } mqttPublishInterval;
+    struct : ConfigWrapper<bool>
+    {
+        bool allowReset() const final { return true; }
+        const char *nvsName() const final { return "mqttTaskStats"; }
+        value_t defaultValue() const final { return false; }
+        ConfigConstraintReturnType checkValue(value_t value) const final { return {}; }
+    } mqttTaskStats;
+
+    // Realtime (DDP, E1.31, WLED udp)
+    struct : ConfigWrapper<bool>
+    {
+        bool allowReset() const final { return true; }
+        const char *nvsName() const final { return "rtEnabled"; }
+        value_t defaultValue() const final { return true; }
+        ConfigConstraintReturnType checkValue(value_t value) const final { return {}; }
+    } realtimeEnabled;
+    struct : ConfigWrapper<milliseconds32>
+    {
+        bool allowReset() const final { return true; }
+        const char *nvsName() const final { return "rtTimeout"; }
+        value_t defaultValue() const final { return milliseconds32{2500}; }
+        ConfigConstraintReturnType checkValue(value_t value) const final { return {}; }
+    } realtimeTimeout;
+    struct : ConfigWrapper<uint16_t>
+    {
+        bool allowReset() const final { return true; }
+        const char *nvsName() const final { return "rtUniverse"; }
+        value_t defaultValue() const final { return 1; }
+        ConfigConstraintReturnType checkValue(value_t value) const final { return {}; }
+    } realtimeUniverse;
 
     // Customization
     /*-- Hide Clock while NTP sync has not finished --*/
@@ -494,6 +585,19 @@ public:
         value_t defaultValue() const final { return true; }
         ConfigConstraintReturnType checkValue(value_t value) const final { return {}; }
     } ledAnimationEnabled;
+    struct : ConfigWrapper<std::string>
+    {
+        bool allowReset() const final { return true; }
+        const char *nvsName() const final { return "customEffect"; }
+        // hue gradient along the strip that scrolls slowly, see tools/effect-asm
+        value_t defaultValue() const final { return "01001213034022200201020141"; }
+        ConfigConstraintReturnType checkValue(value_t value) const final
+        {
+            if (const auto res = effectvm::parse(value); !res)
+                return std::unexpected(res.error());
+            return {};
+        }
+    } customEffect;
     struct : ConfigWrapper<ColorHelper>
     {
         bool allowReset() const final { return true; }
@@ -522,6 +626,13 @@ public:
         value_t defaultValue() const final { return 1; }
         ConfigConstraintReturnType checkValue(value_t value) const final { return {}; }
     } animationMultiplier;
+    struct : ConfigWrapper<uint16_t>
+    {
+        bool allowReset() const final { return true; }
+        const char *nvsName() const final { return "animTransition"; }
+        value_t defaultValue() const final { return 500; }
+        ConfigConstraintReturnType checkValue(value_t value) const final { return {}; }
+    } animationTransitionDuration;
 
     /*-- Disable dot blinking --*/
     struct : ConfigWrapper<bool>
@@ -592,6 +703,12 @@ public:
         ITER_CONFIG(ledMilliAmpereBarrelJack)
         ITER_CONFIG(ledOverrideDigits)
         ITER_CONFIG(ledOverrideDigitsTimeout)
+        ITER_CONFIG(marqueeStepInterval)
+        ITER_CONFIG(marqueeLoops)
+        ITER_CONFIG(digitTransition)
+        ITER_CONFIG(digitTransitionDuration)
+        ITER_CONFIG(ledGamma)
+        ITER_CONFIG(ledDithering)
 
         // Time
         ITER_CONFIG(timeOffset)
@@ -613,15 +730,23 @@ public:
         ITER_CONFIG(mqttTopic)
         ITER_CONFIG(hassMqttTopic)
         ITER_CONFIG(mqttPublishInterval)
+        ITER_CONFIG(mqttTaskStats)
+
+        // Realtime
+        ITER_CONFIG(realtimeEnabled)
+        ITER_CONFIG(realtimeTimeout)
+        ITER_CONFIG(realtimeUniverse)
 
         // Customization
         ITER_CONFIG(showUnsyncedTime)
         ITER_CONFIG(ledAnimation)
         ITER_CONFIG(ledAnimationEnabled)
+        ITER_CONFIG(customEffect)
         ITER_CONFIG(primaryColor)
         ITER_CONFIG(secondaryColor)
         ITER_CONFIG(tertiaryColor)
         ITER_CONFIG(animationMultiplier)
+        ITER_CONFIG(animationTransitionDuration)
         ITER_CONFIG(disableDotBlinking)
         ITER_CONFIG(noClockDigits)
 
@@ -631,3 +756,22 @@ public:
 #undef ITER_CONFIG
     }
 };
+
+namespace configutils {
+
+// called after every successful write, keeps state derived from the configs in sync
+void configWritten(const ConfigWrapperInterface& config);
+
+// use instead of configs.write_config() so derived state notices the change
+template<typename T, typename V>
+auto write_config(ConfigWrapper<T>& config, V&& value)
+{
+    auto result = configs.write_config(config, std::forward<V>(value));
+
+    if (result)
+        configWritten(config);
+
+    return result;
+}
+
+} // namespace configutils
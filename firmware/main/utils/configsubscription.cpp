@@ -0,0 +1,35 @@
+#include "configsubscription.h"
+
+// local includes
+#include "utils/config.h"
+
+namespace configutils {
+
+namespace {
+
+// only written during static initialization, so walking it needs no lock
+ConfigSubscription* subscriptions{nullptr};
+
+} // namespace
+
+ConfigSubscription::ConfigSubscription(const Filter filter, const bool changed)
+    : m_filter{filter}, m_changed{changed}, m_next{subscriptions}
+{
+    subscriptions = this;
+}
+
+void configWritten(const ConfigWrapperInterface& config)
+{
+    for (auto* subscription = subscriptions; subscription; subscription = subscription->m_next)
+    {
+        if (!subscription->m_filter(config))
+            continue;
+
+        subscription->markChanged();
+
+        if (const auto task = subscription->m_task.load(std::memory_order_acquire))
+            xTaskNotifyGive(task);
+    }
+}
+
+} // namespace configutils
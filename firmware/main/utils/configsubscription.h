@@ -0,0 +1,57 @@
+#pragma once
+
+// system includes
+#include <atomic>
+
+// esp-idf includes
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// 3rdparty lib includes
+#include <configwrapper.h>
+
+// Lets subsystems react to config writes instead of comparing values on every update.
+// Subscriptions are meant to have static storage duration, they register themselves on
+// construction and configutils::configWritten() walks them after every successful write.
+namespace configutils {
+
+// true if config is one of the given wrappers
+template<typename... T>
+bool isAnyOf(const ConfigWrapperInterface& config, const T&... wrappers)
+{
+    return ((&config == static_cast<const ConfigWrapperInterface*>(&wrappers)) || ...);
+}
+
+class ConfigSubscription
+{
+public:
+    // decides which configs belong to this subscription, a single key or a whole group
+    using Filter = bool(*)(const ConfigWrapperInterface& config);
+
+    // starts out changed, so the first consume() lets the subscriber apply the current values
+    explicit ConfigSubscription(Filter filter, bool changed = true);
+
+    ConfigSubscription(const ConfigSubscription&) = delete;
+    ConfigSubscription& operator=(const ConfigSubscription&) = delete;
+
+    // true once after a matching config has been written
+    bool consume() { return m_changed.exchange(false, std::memory_order_acq_rel); }
+
+    // for subscribers that could not apply a change and want to retry on their next update
+    void markChanged() { m_changed.store(true, std::memory_order_release); }
+
+    // additionally notifies the task (xTaskNotifyGive) on every matching write
+    void notifyTask(TaskHandle_t task) { m_task.store(task, std::memory_order_release); }
+
+private:
+    friend void configWritten(const ConfigWrapperInterface& config);
+
+    const Filter m_filter;
+
+    std::atomic<bool> m_changed;
+    std::atomic<TaskHandle_t> m_task{nullptr};
+
+    ConfigSubscription* m_next{nullptr};
+};
+
+} // namespace configutils
@@ -9,3 +9,4 @@
 
 IMPLEMENT_NVS_GET_SET_ENUM(SecondaryBrightnessMode)
 IMPLEMENT_NVS_GET_SET_ENUM(LedAnimationName)
+IMPLEMENT_NVS_GET_SET_ENUM(DigitTransition)
@@ -4,3 +4,4 @@
 
 INSTANTIATE_CONFIGWRAPPER_TEMPLATES(SecondaryBrightnessMode)
 INSTANTIATE_CONFIGWRAPPER_TEMPLATES(LedAnimationName)
+INSTANTIATE_CONFIGWRAPPER_TEMPLATES(DigitTransition)
@@ -0,0 +1,137 @@
+#include "deadlinetask.h"
+
+constexpr const char * const TAG = "tasks";
+
+// esp-idf includes
+#include <esp_log.h>
+#include <esp_timer.h>
+
+int64_t DeadlineTask::intervalUs() const
+{
+    return std::chrono::microseconds{m_interval}.count();
+}
+
+void DeadlineTask::setup()
+{
+    m_setupCallback();
+
+    m_deadline = esp_timer_get_time() + intervalUs();
+}
+
+void DeadlineTask::loop()
+{
+    const auto start = esp_timer_get_time();
+    const auto requested = m_runRequested.exchange(false, std::memory_order_relaxed);
+
+    if (start < m_deadline)
+    {
+        if (!requested)
+        {
+            return;
+        }
+
+        // an early run starts the interval over
+        m_deadline = start + intervalUs();
+    }
+    else
+    {
+        portENTER_CRITICAL(&m_statsLock);
+        m_lateness.record(start - m_deadline);
+        portEXIT_CRITICAL(&m_statsLock);
+
+        // keep the nominal rhythm, but do not catch up on runs that were missed completely
+        m_deadline += intervalUs();
+        if (m_deadline <= start)
+        {
+            m_deadline = start + intervalUs();
+        }
+    }
+
+    m_loopCallback();
+    const std::chrono::microseconds elapsed{esp_timer_get_time() - start};
+
+    portENTER_CRITICAL(&m_statsLock);
+
+    m_executionTimes.record(elapsed.count());
+
+    ++m_current.callCount;
+    m_current.lastElapsed = elapsed;
+    m_current.maxElapsed = std::max(m_current.maxElapsed, elapsed);
+    m_current.totalElapsed += elapsed;
+
+    portEXIT_CRITICAL(&m_statsLock);
+}
+
+espchrono::millis_clock::time_point DeadlineTask::nextDeadline() const
+{
+    const auto now = espchrono::millis_clock::now();
+
+    if (m_runRequested.load(std::memory_order_relaxed))
+    {
+        return now;
+    }
+
+    return now + std::chrono::ceil<espchrono::milliseconds32>(std::chrono::microseconds{m_deadline - esp_timer_get_time()});
+}
+
+std::chrono::microseconds DeadlineTask::averageElapsed() const
+{
+    const auto published = publishedStats();
+
+    if (!published.callCount)
+    {
+        return {};
+    }
+
+    return published.totalElapsed / published.callCount;
+}
+
+Histogram DeadlineTask::executionTimes() const
+{
+    portENTER_CRITICAL(&m_statsLock);
+    const auto histogram = m_executionTimes;
+    portEXIT_CRITICAL(&m_statsLock);
+
+    return histogram;
+}
+
+Histogram DeadlineTask::lateness() const
+{
+    portENTER_CRITICAL(&m_statsLock);
+    const auto histogram = m_lateness;
+    portEXIT_CRITICAL(&m_statsLock);
+
+    return histogram;
+}
+
+DeadlineTask::Stats DeadlineTask::publishedStats() const
+{
+    portENTER_CRITICAL(&m_statsLock);
+    const auto published = m_published;
+    portEXIT_CRITICAL(&m_statsLock);
+
+    return published;
+}
+
+void DeadlineTask::pushStats(const bool printTask)
+{
+    portENTER_CRITICAL(&m_statsLock);
+
+    // slow tasks do not run in every period, keep showing their last run
+    const auto lastElapsed = m_current.callCount ? m_current.lastElapsed : m_published.lastElapsed;
+
+    m_published = m_current;
+    m_published.lastElapsed = lastElapsed;
+    m_current = Stats{};
+
+    const auto published = m_published;
+
+    portEXIT_CRITICAL(&m_statsLock);
+
+    if (printTask)
+    {
+        ESP_LOGI(TAG, "%s: count=%lu last=%lldus avg=%lldus max=%lldus total=%lldus",
+                 m_name, published.callCount, published.lastElapsed.count(), averageElapsed().count(),
+                 published.maxElapsed.count(), published.totalElapsed.count());
+    }
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+// system includes
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// esp-idf includes
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// 3rdparty lib includes
+#include <espchrono.h>
+
+// local includes
+#include "utils/histogram.h"
+
+// Cooperative task of the app_main loop. Same stats as espcpputils::SchedulerTask, but it
+// knows its next deadline, so the loop can block until the earliest one instead of polling
+// every tick.
+class DeadlineTask
+{
+public:
+    using Callback = void (*)();
+
+    DeadlineTask(const char* name, Callback setupCallback, Callback loopCallback, espchrono::milliseconds32 interval)
+        : m_name{name}, m_setupCallback{setupCallback}, m_loopCallback{loopCallback}, m_interval{interval}
+    {}
+
+    const char* name() const { return m_name; }
+
+    espchrono::milliseconds32 interval() const { return m_interval; }
+
+    void setup();
+
+    // runs the loop callback if the deadline passed or a run was requested
+    void loop();
+
+    espchrono::millis_clock::time_point nextDeadline() const;
+
+    // makes the task due right away, safe to call from other tasks
+    void requestRun() { m_runRequested.store(true, std::memory_order_relaxed); }
+
+    // set when the task loops in a FreeRTOS task of its own instead of the app_main loop
+    TaskHandle_t taskHandle() const { return m_taskHandle; }
+
+    void setTaskHandle(const TaskHandle_t handle) { m_taskHandle = handle; }
+
+    // moves the stats of the current period into the published ones
+    void pushStats(bool printTask);
+
+    // stats of the last pushStats() period, copied under the stats lock
+    uint32_t callCount() const { return publishedStats().callCount; }
+    std::chrono::microseconds lastElapsed() const { return publishedStats().lastElapsed; }
+    std::chrono::microseconds averageElapsed() const;
+    std::chrono::microseconds maxElapsed() const { return publishedStats().maxElapsed; }
+    std::chrono::microseconds totalElapsed() const { return publishedStats().totalElapsed; }
+
+    // since boot, in microseconds, a copy because the task may be recording in another task
+    Histogram executionTimes() const;
+
+    // how long after its deadline a run started, in microseconds, requested runs are left out
+    Histogram lateness() const;
+
+private:
+    int64_t intervalUs() const;
+
+    struct Stats
+    {
+        uint32_t callCount{};
+        std::chrono::microseconds lastElapsed{};
+        std::chrono::microseconds maxElapsed{};
+        std::chrono::microseconds totalElapsed{};
+    };
+
+    Stats publishedStats() const;
+
+    const char* m_name;
+    Callback m_setupCallback;
+    Callback m_loopCallback;
+    espchrono::milliseconds32 m_interval;
+
+    // esp_timer microseconds
+    int64_t m_deadline{};
+    std::atomic<bool> m_runRequested{};
+
+    TaskHandle_t m_taskHandle{};
+
+    // loop() runs in app_main or the own task, pushStats() in app_main and the readers in
+    // httpd or mqtt, so everything below is only touched inside this critical section
+    mutable portMUX_TYPE m_statsLock = portMUX_INITIALIZER_UNLOCKED;
+
+    Stats m_current{};
+    Stats m_published{};
+
+    Histogram m_executionTimes;
+    Histogram m_lateness;
+};
@@ -15,6 +15,8 @@ constexpr const char * const TAG = "espclock";
 #include "peripheral/ledhelpers/ledanimation.h"
 #include "peripheral/ledmanager.h"
 #include "utils/config.h"
+#include "utils/configsubscription.h"
+#include "utils/renderconfig.h"
 
 espchrono::time_zone get_default_timezone() noexcept
 {
@@ -90,6 +92,23 @@ namespace {
 bool time_synced{false};
 bool time_synced_prev{false};
 
+// begin() applies the initial sntp settings
+configutils::ConfigSubscription sntpConfigChanged{[](const ConfigWrapperInterface& config) {
+    return configutils::isAnyOf(config, configs.timeServer, configs.timeSyncMode, configs.timeSyncInterval);
+}, false};
+
+configutils::ConfigSubscription sunPositionChanged{[](const ConfigWrapperInterface& config) {
+    return configutils::isAnyOf(config, configs.sunriseLatitude, configs.sunriseLongitude);
+}, false};
+
+void applySntpConfig()
+{
+    // lwip keeps the pointer, it stays valid until the next write, which lands here again
+    esp_sntp_setservername(0, configs.timeServer.value().c_str());
+    esp_sntp_set_sync_mode(configs.timeSyncMode.value());
+    esp_sntp_set_sync_interval(espchrono::milliseconds32{configs.timeSyncInterval.value()}.count());
+}
+
 void time_sync_notification_cb(struct timeval *tv)
 {
     if (tv == nullptr)
@@ -108,7 +127,13 @@ void time_sync_notification_cb(struct timeval *tv)
 
 void setTimeInLedManager()
 {
-    if (ledmanager::ledManager && configs.ledOverrideDigits.value().empty())
+    if (!ledmanager::ledManager)
+        return;
+
+    // the render task reads the digits and rebuilds the render config under this lock
+    espcpputils::RecursiveLockHelper guard{ledmanager::led_lock->handle};
+
+    if (!renderconfig::get().overrideDigitsActive)
     {
         auto& ledManager = *ledmanager::ledManager;
 
@@ -137,10 +162,8 @@ void begin()
     esp_sntp_setoperatingmode(ESP_SNTP_OPMODE_POLL);
     static_assert(SNTP_MAX_SERVERS >= 1);
 
-    esp_sntp_setservername(0, configs.timeServer.value().c_str());
     esp_sntp_set_time_sync_notification_cb(time_sync_notification_cb);
-    esp_sntp_set_sync_mode(configs.timeSyncMode.value());
-    esp_sntp_set_sync_interval(espchrono::milliseconds32{configs.timeSyncInterval.value()}.count());
+    applySntpConfig();
 
     esp_sntp_init();
 
@@ -152,6 +175,18 @@ void begin()
 
 void update()
 {
+    if (sntpConfigChanged.consume() && esp_sntp_enabled())
+    {
+        applySntpConfig();
+        esp_sntp_restart();
+    }
+
+    if (sunPositionChanged.consume())
+    {
+        // recalculated on the next sunrise()/sunset() call
+        last_sync_time.reset();
+    }
+
     setTimeInLedManager();
 }
 
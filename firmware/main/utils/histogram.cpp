@@ -0,0 +1,55 @@
+#include "histogram.h"
+
+// system includes
+#include <algorithm>
+
+namespace {
+
+static_assert(Histogram::bucketIndex(0) == 0);
+static_assert(Histogram::bucketIndex(3) == 3);
+static_assert(Histogram::bucketIndex(4) == 4);
+static_assert(Histogram::bucketIndex(6) == 5);
+static_assert(Histogram::bucketIndex(8) == 6);
+static_assert(Histogram::bucketLowerBound(5) == 6);
+static_assert(Histogram::bucketLowerBound(6) == 8);
+static_assert(Histogram::bucketIndex(Histogram::bucketLowerBound(Histogram::BUCKET_COUNT - 1)) == Histogram::BUCKET_COUNT - 1);
+static_assert(Histogram::bucketIndex(UINT32_MAX) == Histogram::BUCKET_COUNT - 1);
+
+} // namespace
+
+void Histogram::record(const uint32_t value)
+{
+    ++m_buckets[bucketIndex(value)];
+    ++m_count;
+    m_sum += value;
+    m_max = std::max(m_max, value);
+}
+
+void Histogram::reset()
+{
+    *this = {};
+}
+
+uint32_t Histogram::percentile(const uint8_t percent) const
+{
+    if (!m_count)
+        return 0;
+
+    // rank of the sample, rounded up so p100 is the last one
+    const uint32_t rank = std::max<uint32_t>(1, (static_cast<uint64_t>(m_count) * percent + 99) / 100);
+
+    uint32_t seen{};
+
+    for (size_t i = 0; i < BUCKET_COUNT; ++i)
+    {
+        seen += m_buckets[i];
+
+        if (seen >= rank)
+        {
+            const uint32_t upperBound = i + 1 < BUCKET_COUNT ? bucketLowerBound(i + 1) - 1 : m_max;
+            return std::min(upperBound, m_max);
+        }
+    }
+
+    return m_max;
+}
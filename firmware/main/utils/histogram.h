@@ -0,0 +1,60 @@
+#pragma once
+
+// system includes
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Fixed bucket histogram for durations and other non negative samples. The first four
+// buckets hold exact values, above that every power of two is split into two buckets,
+// so the relative error stays below 50% from microseconds up to seconds.
+class Histogram
+{
+public:
+    static constexpr size_t BUCKET_COUNT = 44;
+
+    void record(uint32_t value);
+
+    void reset();
+
+    uint32_t count() const { return m_count; }
+
+    uint32_t max() const { return m_max; }
+
+    uint64_t sum() const { return m_sum; }
+
+    uint32_t average() const { return m_count ? m_sum / m_count : 0; }
+
+    // upper bound of the bucket holding the percentile, capped at the largest sample
+    uint32_t percentile(uint8_t percent) const;
+
+    const std::array<uint32_t, BUCKET_COUNT>& buckets() const { return m_buckets; }
+
+    static constexpr size_t bucketIndex(const uint32_t value)
+    {
+        if (value < 4)
+            return value;
+
+        const size_t msb = 31 - __builtin_clz(value);
+        const size_t index = 4 + (msb - 2) * 2 + ((value >> (msb - 1)) & 1);
+
+        return index < BUCKET_COUNT ? index : BUCKET_COUNT - 1;
+    }
+
+    // smallest value that lands in the bucket
+    static constexpr uint32_t bucketLowerBound(const size_t index)
+    {
+        if (index < 4)
+            return index;
+
+        const size_t msb = (index - 4) / 2 + 2;
+
+        return (1u << msb) | (((index - 4) % 2) << (msb - 1));
+    }
+
+private:
+    std::array<uint32_t, BUCKET_COUNT> m_buckets{};
+    uint32_t m_count{};
+    uint32_t m_max{};
+    uint64_t m_sum{};
+};
@@ -0,0 +1,273 @@
+#include "logbuffer.h"
+
+constexpr const char * const TAG = "logbuffer";
+
+// system includes
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+// esp-idf includes
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// local includes
+#include "utils/taskplacement.h"
+
+namespace logbuffer {
+
+namespace {
+
+struct Line
+{
+    // sequence number + 1 of the line in text, 0 while empty or being written
+    std::atomic<uint32_t> sequence{};
+    uint16_t length{};
+    // already written to the uart by the logging task, the drain task skips it
+    bool direct{};
+    char text[LINE_LENGTH];
+};
+
+Line lines[LINE_COUNT];
+
+std::atomic<uint32_t> nextSequence{};
+portMUX_TYPE ringLock = portMUX_INITIALIZER_UNLOCKED;
+
+std::atomic<vprintf_like_t> uartVprintf{nullptr};
+
+// esp_log starts every line with its level letter, behind the color code if colors are on
+bool isError(const char* text, const size_t length)
+{
+    size_t i{};
+
+    if (length && text[0] == '\033')
+    {
+        while (i < length && text[i] != 'm')
+            ++i;
+        ++i;
+    }
+
+    return i + 1 < length && text[i] == 'E' && text[i + 1] == ' ';
+}
+
+// limiter state of one call site, keyed by its format string
+struct Burst
+{
+    const char* format{};
+    uint32_t windowStart{};
+    uint32_t lines{};
+    uint32_t suppressed{};
+};
+
+// call sites sharing a slot just reset each other's window
+std::array<Burst, 32> bursts;
+
+// lines suppressed since the call site last went through, nullopt while it is limited
+std::optional<uint32_t> admit(const char* format)
+{
+    const auto now = static_cast<uint32_t>(espchrono::millis_clock::now().time_since_epoch().count());
+    auto& burst = bursts[(reinterpret_cast<uintptr_t>(format) >> 2) % bursts.size()];
+
+    std::optional<uint32_t> result;
+
+    portENTER_CRITICAL(&ringLock);
+
+    if (burst.format != format || now - burst.windowStart >= uint32_t(RATE_LIMIT_WINDOW.count()))
+    {
+        result = burst.format == format ? std::exchange(burst.suppressed, 0) : 0;
+        burst = Burst{ .format = format, .windowStart = now, .lines = 1 };
+    }
+    else if (burst.lines < RATE_LIMIT_LINES)
+    {
+        ++burst.lines;
+        result = 0;
+    }
+    else
+    {
+        ++burst.suppressed;
+    }
+
+    portEXIT_CRITICAL(&ringLock);
+
+    return result;
+}
+
+void publish(const char* text, const size_t length, const bool direct)
+{
+    // writers on both cores can lap the ring during a burst, only one of them may fill a slot at a time
+    portENTER_CRITICAL(&ringLock);
+
+    const auto sequence = nextSequence.fetch_add(1, std::memory_order_relaxed);
+    auto& line = lines[sequence % LINE_COUNT];
+
+    line.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::memcpy(line.text, text, length);
+    line.length = length;
+    line.direct = direct;
+    line.sequence.store(sequence + 1, std::memory_order_release);
+
+    portEXIT_CRITICAL(&ringLock);
+}
+
+int ringVprintf(const char* format, va_list args)
+{
+    // esp_log hands over the same format literal for every line of a call site
+    const auto suppressed = admit(format);
+    if (!suppressed)
+        return 0;
+
+    // formatted on the stack, the slot is only touched inside publish()
+    char text[LINE_LENGTH];
+
+    if (*suppressed)
+    {
+        const auto length = std::snprintf(text, LINE_LENGTH, "--- %lu similar log lines suppressed ---\n", static_cast<unsigned long>(*suppressed));
+        publish(text, std::clamp<int>(length, 0, LINE_LENGTH - 1), false);
+    }
+
+    va_list uartArgs;
+    va_copy(uartArgs, args);
+
+    const auto written = std::vsnprintf(text, LINE_LENGTH, format, args);
+    size_t length = std::clamp<int>(written, 0, LINE_LENGTH - 1);
+
+    // keep the line break of truncated lines
+    if (written >= static_cast<int>(LINE_LENGTH))
+        text[length - 1] = '\n';
+
+    // errors are often the last thing before a crash or reset, do not leave them waiting in the ring.
+    // They can show up on the uart ahead of older lines the drain task has not written yet.
+    bool direct{};
+    if (isError(text, length))
+    {
+        if (const auto uart = uartVprintf.load(std::memory_order_relaxed))
+        {
+            uart(format, uartArgs);
+            direct = true;
+        }
+    }
+
+    va_end(uartArgs);
+
+    publish(text, length, direct);
+
+    return length;
+}
+
+// read() that also tells whether the line was written to the uart already
+std::optional<size_t> readLine(const uint32_t sequence, char* out, bool& direct)
+{
+    const auto& line = lines[sequence % LINE_COUNT];
+
+    if (line.sequence.load(std::memory_order_acquire) != sequence + 1)
+        return std::nullopt;
+
+    const size_t length = line.length;
+    direct = line.direct;
+    std::memcpy(out, line.text, length);
+
+    // the writer may have lapped us while copying
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (line.sequence.load(std::memory_order_relaxed) != sequence + 1)
+        return std::nullopt;
+
+    return length;
+}
+
+void writeUart(const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    uartVprintf.load(std::memory_order_relaxed)(format, args);
+    va_end(args);
+}
+
+[[noreturn]] void drain_task(void*)
+{
+    uint32_t cursor{};
+    char text[LINE_LENGTH];
+
+    while (true)
+    {
+        for (auto end = head(); cursor != end; end = head())
+        {
+            if (end - cursor > LINE_COUNT)
+            {
+                const auto dropped = end - LINE_COUNT - cursor;
+                writeUart("--- %lu log lines dropped ---\n", static_cast<unsigned long>(dropped));
+                cursor += dropped;
+                continue;
+            }
+
+            // a writer got preempted while formatting, try again next round
+            bool direct{};
+            const auto length = readLine(cursor, text, direct);
+            if (!length)
+                break;
+
+            if (!direct)
+                writeUart("%.*s", static_cast<int>(*length), text);
+            ++cursor;
+        }
+
+        vTaskDelay(pdMS_TO_TICKS(20));
+    }
+}
+
+} // namespace
+
+void begin()
+{
+    if (uartVprintf.load(std::memory_order_relaxed))
+        return;
+
+    if (const auto result = taskplacement::createTask(drain_task, "logDrain", nullptr, nullptr); result != pdPASS)
+    {
+        ESP_LOGE(TAG, "failed creating drain task %d", result);
+        return;
+    }
+
+    uartVprintf.store(esp_log_set_vprintf(ringVprintf), std::memory_order_relaxed);
+}
+
+uint32_t head()
+{
+    return nextSequence.load(std::memory_order_relaxed);
+}
+
+uint32_t tail()
+{
+    const auto end = head();
+    return end > LINE_COUNT ? end - LINE_COUNT : 0;
+}
+
+std::optional<size_t> read(const uint32_t sequence, char* out)
+{
+    bool direct;
+    return readLine(sequence, out, direct);
+}
+
+std::optional<uint32_t> RateLimiter::check()
+{
+    const auto now = static_cast<uint32_t>(espchrono::millis_clock::now().time_since_epoch().count());
+    auto last = m_last.load(std::memory_order_relaxed);
+
+    // call sites are shared by several tasks, the exchange lets only one of them through per interval
+    if ((!m_started.load(std::memory_order_relaxed) || now - last >= uint32_t(m_interval.count())) &&
+        m_last.compare_exchange_strong(last, now, std::memory_order_relaxed))
+    {
+        m_started.store(true, std::memory_order_relaxed);
+        return m_suppressed.exchange(0, std::memory_order_relaxed);
+    }
+
+    m_suppressed.fetch_add(1, std::memory_order_relaxed);
+    return std::nullopt;
+}
+
+} // namespace logbuffer
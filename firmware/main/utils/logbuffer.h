@@ -0,0 +1,72 @@
+#pragma once
+
+// system includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+// esp-idf includes
+#include <esp_log.h>
+
+// 3rdparty lib includes
+#include <espchrono.h>
+
+namespace logbuffer {
+
+// esp_log output goes into a ring of fixed size lines instead of straight to the uart.
+// Writers format on their own stack and copy the line into a slot, a low priority task drains the ring.
+// Errors are written to the uart right away as well, so they survive a crash.
+constexpr size_t LINE_COUNT = 64;
+constexpr size_t LINE_LENGTH = 160;
+
+// every call site (format string) may log this many lines per window, the rest is counted
+// and reported with its next line that goes through
+constexpr uint32_t RATE_LIMIT_LINES = 20;
+constexpr espchrono::milliseconds32 RATE_LIMIT_WINDOW{1000};
+
+// redirects esp_log into the ring and starts the drain task
+void begin();
+
+// sequence number the next line will get
+uint32_t head();
+
+// oldest sequence number that may still be in the ring
+uint32_t tail();
+
+// copies the line into out (LINE_LENGTH bytes), nullopt if it was overwritten or is still being written
+std::optional<size_t> read(uint32_t sequence, char* out);
+
+// lets one call per interval through, see LOG_RATELIMITED
+class RateLimiter
+{
+public:
+    constexpr explicit RateLimiter(espchrono::milliseconds32 interval) : m_interval{interval} {}
+
+    // number of calls suppressed since the last one that went through, nullopt while limiting
+    std::optional<uint32_t> check();
+
+private:
+    const espchrono::milliseconds32 m_interval;
+    // millis_clock milliseconds, wraps
+    std::atomic<uint32_t> m_last{};
+    std::atomic<bool> m_started{};
+    std::atomic<uint32_t> m_suppressed{};
+};
+
+} // namespace logbuffer
+
+// ESP_LOG_LEVEL_LOCAL with a longer interval than the backend limit, e.g. LOG_RATELIMITED(ESP_LOG_INFO, 10s, TAG, "...", ...)
+#define LOG_RATELIMITED(level, interval, tag, format, ...) \
+    do { \
+        static logbuffer::RateLimiter logRateLimiter{interval}; \
+        if (LOG_LOCAL_LEVEL >= level) \
+        { \
+            if (const auto suppressed = logRateLimiter.check()) \
+            { \
+                if (*suppressed) \
+                    ESP_LOG_LEVEL_LOCAL(level, tag, "%lu similar messages suppressed", static_cast<unsigned long>(*suppressed)); \
+                ESP_LOG_LEVEL_LOCAL(level, tag, format, ##__VA_ARGS__); \
+            } \
+        } \
+    } while (false)
@@ -0,0 +1,104 @@
+#include "renderconfig.h"
+
+// system includes
+#include <array>
+#include <atomic>
+
+// local includes
+#include "utils/config.h"
+#include "utils/configsubscription.h"
+
+namespace renderconfig {
+
+namespace {
+
+// two slots, the render task fills the one that is not published
+std::array<RenderConfig, 2> snapshots;
+std::atomic<const RenderConfig*> published{&snapshots[0]};
+
+CRGB toCRGB(const cpputils::ColorHelper& color)
+{
+    return CRGB{color.r, color.g, color.b};
+}
+
+configutils::ConfigSubscription renderConfigChanged{[](const ConfigWrapperInterface& config) {
+    return configutils::isAnyOf(config,
+                                configs.ledOverrideDigits,
+                                configs.ledOverrideDigitsTimeout,
+                                configs.marqueeStepInterval,
+                                configs.marqueeLoops,
+                                configs.digitTransition,
+                                configs.digitTransitionDuration,
+                                configs.primaryColor,
+                                configs.secondaryColor,
+                                configs.tertiaryColor,
+                                configs.animationMultiplier,
+                                configs.disableDotBlinking,
+                                configs.noClockDigits,
+                                configs.ledBrightness,
+                                configs.ledSecondaryBrightness,
+                                configs.ledMilliAmpereUsbC,
+                                configs.ledMilliAmpereBarrelJack,
+                                configs.ledGamma,
+                                configs.ledDithering,
+                                configs.realtimeEnabled,
+                                configs.realtimeTimeout,
+                                configs.realtimeUniverse);
+}};
+
+} // namespace
+
+const RenderConfig& get()
+{
+    return *published.load(std::memory_order_acquire);
+}
+
+void refresh()
+{
+    if (!renderConfigChanged.consume())
+        return;
+
+    const auto* current = published.load(std::memory_order_relaxed);
+
+    auto& next = current == &snapshots[0] ? snapshots[1] : snapshots[0];
+
+    next.generation = current->generation + 1;
+
+    next.overrideDigits = configs.ledOverrideDigits.value();
+    next.overrideDigitsActive = !next.overrideDigits.empty();
+    next.overrideDigitsTimeout = configs.ledOverrideDigitsTimeout.value();
+    next.marqueeStepMs = configs.marqueeStepInterval.value().count();
+    next.marqueeLoops = configs.marqueeLoops.value();
+
+    next.digitTransition = configs.digitTransition.value();
+    next.digitTransitionMs = configs.digitTransitionDuration.value().count();
+
+    next.primaryColor = toCRGB(configs.primaryColor.value());
+    next.secondaryColor = toCRGB(configs.secondaryColor.value());
+    next.tertiaryColor = toCRGB(configs.tertiaryColor.value());
+
+    next.animationMultiplier = configs.animationMultiplier.value();
+    next.disableDotBlinking = configs.disableDotBlinking.value();
+    next.noClockDigits = configs.noClockDigits.value();
+
+    next.brightness = configs.ledBrightness.value();
+    next.secondaryBrightness = configs.ledSecondaryBrightness.value();
+    next.milliAmpereUsbC = configs.ledMilliAmpereUsbC.value();
+    next.milliAmpereBarrelJack = configs.ledMilliAmpereBarrelJack.value();
+
+    next.gamma = configs.ledGamma.value();
+    next.dithering = configs.ledDithering.value();
+
+    next.realtimeEnabled = configs.realtimeEnabled.value();
+    next.realtimeTimeoutMs = configs.realtimeTimeout.value().count();
+    next.realtimeUniverse = configs.realtimeUniverse.value();
+
+    published.store(&next, std::memory_order_release);
+}
+
+void notifyOnChange(TaskHandle_t task)
+{
+    renderConfigChanged.notifyTask(task);
+}
+
+} // namespace renderconfig
@@ -0,0 +1,67 @@
+#pragma once
+
+// system includes
+#include <cstdint>
+#include <string>
+
+// esp-idf includes
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// 3rdparty lib includes
+#include <FastLED.h>
+
+// local includes
+#include "peripheral/ledhelpers/segmenttransition.h"
+
+// Copy of every config the render path reads, so a frame does not walk the config
+// wrappers (and compare strings) over and over. Writes mark the snapshot stale, the
+// render task rebuilds it at the start of the next frame and bumps its generation.
+namespace renderconfig {
+
+struct RenderConfig
+{
+    uint32_t generation{};
+
+    std::string overrideDigits;
+    bool overrideDigitsActive{};
+    uint16_t overrideDigitsTimeout{};
+    uint32_t marqueeStepMs{};
+    // 0 scrolls until the override text is cleared
+    uint8_t marqueeLoops{};
+
+    DigitTransition digitTransition{DigitTransition::Off};
+    uint32_t digitTransitionMs{};
+
+    CRGB primaryColor;
+    CRGB secondaryColor;
+    CRGB tertiaryColor;
+
+    float animationMultiplier{1};
+    bool disableDotBlinking{};
+    bool noClockDigits{};
+
+    uint8_t brightness{};
+    uint8_t secondaryBrightness{};
+    uint32_t milliAmpereUsbC{};
+    uint32_t milliAmpereBarrelJack{};
+
+    float gamma{1};
+    bool dithering{};
+
+    bool realtimeEnabled{};
+    uint32_t realtimeTimeoutMs{};
+    uint16_t realtimeUniverse{};
+};
+
+// the published snapshot, does not lock itself, hold led_lock while using it because
+// refresh() runs under that lock and overwrites the older of its two slots
+const RenderConfig& get();
+
+// rebuilds the snapshot if a render config changed, only call from the render task with led_lock
+void refresh();
+
+// wakes the task whenever a config of the snapshot is written
+void notifyOnChange(TaskHandle_t task);
+
+} // namespace renderconfig
@@ -0,0 +1,98 @@
+#include "taskplacement.h"
+
+constexpr const char * const TAG = "taskplacement";
+
+// system includes
+#include <algorithm>
+#include <array>
+
+// esp-idf includes
+#include <esp_log.h>
+
+namespace taskplacement {
+
+namespace {
+
+using espcpputils::CoreAffinity;
+
+// the led pipeline owns core 1, network and housekeeping share core 0 with app_main
+constexpr std::array placements{
+    //        name           own task  core                 prio  stack
+    Placement{"ledRender",   true,     CoreAffinity::Core1, 10,   4096},
+    Placement{"realtimeUdp", true,     CoreAffinity::Core0,  9,   4096},
+    Placement{"httpd",       true,     CoreAffinity::Core0,  5,   8192},
+    Placement{"mqttSend",    true,     CoreAffinity::Core0,  5,   4096},
+    Placement{"mqttReceive", true,     CoreAffinity::Core0,  5,   4096},
+    Placement{"bme280Read",  true,     CoreAffinity::Core0,  5,   4096},
+    Placement{"logDrain",    true,     CoreAffinity::Core0,  1,   3072},
+
+    // scheduler tasks, an own task runs the same deadline loop as app_main does
+    Placement{"wifi",        false,    CoreAffinity::Core0,  1,   4096},
+    Placement{"mdns",        false,    CoreAffinity::Core0,  1,   4096},
+    Placement{"bme280",      false,    CoreAffinity::Core0,  1,   4096},
+    Placement{"led",         false,    CoreAffinity::Core0,  1,   4096},
+    Placement{"basicleds",   false,    CoreAffinity::Core0,  1,   4096},
+    Placement{"espclock",    false,    CoreAffinity::Core0,  1,   4096},
+    Placement{"webserver",   false,    CoreAffinity::Core0,  1,   4096},
+    Placement{"realtime",    false,    CoreAffinity::Core0,  1,   4096},
+    Placement{"beeper",      false,    CoreAffinity::Core0,  1,   4096},
+    Placement{"mqtt",        false,    CoreAffinity::Core0,  1,   4096},
+    Placement{"ota",         false,    CoreAffinity::Core0,  1,   4096},
+};
+
+constexpr Placement fallback{"unknown", true, CoreAffinity::Both, 1, 4096};
+
+} // namespace
+
+std::span<const Placement> all()
+{
+    return placements;
+}
+
+const Placement& get(const std::string_view name)
+{
+    const auto placement = std::ranges::find_if(placements, [name](const Placement& placement) {
+        return name == placement.name;
+    });
+
+    if (placement == placements.end())
+    {
+        ESP_LOGE(TAG, "no placement for %.*s", int(name.size()), name.data());
+        return fallback;
+    }
+
+    return *placement;
+}
+
+BaseType_t coreId(const espcpputils::CoreAffinity core)
+{
+    switch (core)
+    {
+    case CoreAffinity::Core0: return 0;
+    case CoreAffinity::Core1: return 1;
+    case CoreAffinity::Both: return tskNO_AFFINITY;
+    }
+
+    return tskNO_AFFINITY;
+}
+
+const char* toString(const espcpputils::CoreAffinity core)
+{
+    switch (core)
+    {
+    case CoreAffinity::Core0: return "0";
+    case CoreAffinity::Core1: return "1";
+    case CoreAffinity::Both: return "any";
+    }
+
+    return "any";
+}
+
+BaseType_t createTask(const TaskFunction_t function, const char* name, void* arg, TaskHandle_t* handle)
+{
+    const auto& placement = get(name);
+
+    return espcpputils::createTask(function, name, placement.stackSize, arg, placement.priority, handle, placement.core);
+}
+
+} // namespace taskplacement
@@ -0,0 +1,43 @@
+#pragma once
+
+// system includes
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+// esp-idf includes
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// 3rdparty lib includes
+#include <taskutils.h>
+
+// Where every subsystem runs. The scheduler tasks (utils/tasks.cpp) either run cooperatively in
+// the app_main loop or get a FreeRTOS task of their own, everything that always needs its own
+// task (render, mqtt, httpd, ...) takes core, priority and stack from here as well.
+namespace taskplacement {
+
+struct Placement
+{
+    const char* name;
+    // false runs a scheduler task in the app_main loop, core, priority and stack are unused then
+    bool ownTask;
+    espcpputils::CoreAffinity core;
+    UBaseType_t priority;
+    uint32_t stackSize;
+};
+
+std::span<const Placement> all();
+
+// logs and falls back to a low priority task on any core for names missing in the table
+const Placement& get(std::string_view name);
+
+// core_id for apis that do not take a CoreAffinity, tskNO_AFFINITY for Both
+BaseType_t coreId(espcpputils::CoreAffinity core);
+
+const char* toString(espcpputils::CoreAffinity core);
+
+// espcpputils::createTask() with the placement of name
+BaseType_t createTask(TaskFunction_t function, const char* name, void* arg, TaskHandle_t* handle);
+
+} // namespace taskplacement
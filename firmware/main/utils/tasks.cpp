@@ -2,19 +2,32 @@
 
 constexpr const char * const TAG = "tasks";
 
-// 3rdparty lib includes
-#include <espchrono.h>
+// system includes
+#include <algorithm>
+#include <atomic>
+#include <string_view>
+
+// esp-idf includes
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// esp-idf optional includes
+#if defined(CONFIG_ESP_TASK_WDT_PANIC) || defined(CONFIG_ESP_TASK_WDT)
+#include <esp_task_wdt.h>
+#endif
 
 // local includes
 #include "communication/mdns_clock.h"
 #include "communication/mqtt.h"
 #include "communication/ota.h"
+#include "communication/realtime.h"
 #include "communication/webserver.h"
 #include "communication/wifi.h"
 #include "espclock.h"
 #include "peripheral/basicleds.h"
 #include "peripheral/beeper.h"
 #include "peripheral/ledmanager.h"
+#include "utils/taskplacement.h"
 
 // optional local includes
 #ifdef HARDWARE_USE_BME280
@@ -25,27 +38,103 @@ namespace {
 
 void noop() {}
 
-using namespace espcpputils;
 using namespace std::chrono_literals;
 
-SchedulerTask tasksArray[]{
-    SchedulerTask{"wifi",      wifi::begin,          wifi::update,      300ms},
-    SchedulerTask{"mdns",      mdns::begin,          mdns::update,      300ms},
+// the task running the scheduler loop, known once it waits for the first time
+std::atomic<TaskHandle_t> schedulerTask{nullptr};
+
+DeadlineTask tasksArray[]{
+    DeadlineTask{"wifi",      wifi::begin,          wifi::update,      300ms},
+    DeadlineTask{"mdns",      mdns::begin,          mdns::update,      300ms},
 #ifdef HARDWARE_USE_BME280
-    SchedulerTask{"bme280",    bme280_sensor::begin, noop,                 1s},
+    DeadlineTask{"bme280",    bme280_sensor::begin, noop,                 1s},
 #endif
-    SchedulerTask{"led",       ledmanager::begin,    ledmanager::update, 8ms},
-    SchedulerTask{"basicleds", basicleds::begin,     basicleds::update,  60ms},
-    SchedulerTask{"espclock",  espclock::begin,      espclock::update,  100ms},
-    SchedulerTask{"webserver", webserver::begin,     noop,                 1s},
-    SchedulerTask{"beeper",    beeper::begin,        beeper::update,     16ms},
-    SchedulerTask{"mqtt",      mqtt::begin,          mqtt::update,      500ms},
-    SchedulerTask{"ota",       ota::begin,           ota::update,       100ms},
+    DeadlineTask{"led",       ledmanager::begin,    noop,                 1s},
+    DeadlineTask{"basicleds", basicleds::begin,     basicleds::update,  60ms},
+    DeadlineTask{"espclock",  espclock::begin,      espclock::update,  100ms},
+    DeadlineTask{"webserver", webserver::begin,     webserver::update,  50ms},
+    DeadlineTask{"realtime",  realtime::begin,      noop,                 1s},
+    DeadlineTask{"beeper",    beeper::begin,        beeper::update,     16ms},
+    DeadlineTask{"mqtt",      mqtt::begin,          mqtt::update,      500ms},
+    DeadlineTask{"ota",       ota::begin,           ota::update,       100ms},
 };
 
+void waitUntil(const espchrono::millis_clock::time_point deadline)
+{
+    const auto remaining = deadline - espchrono::millis_clock::now();
+
+    if (remaining.count() <= 0)
+    {
+        return;
+    }
+
+    // round up, waking up a tick early would only find nothing due
+    const TickType_t ticks = (remaining.count() + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS;
+
+    ulTaskNotifyTake(pdTRUE, ticks);
+}
+
+// same deadline loop as app_main, for a single task
+[[noreturn]] void own_task(void* arg)
+{
+    auto& task = *static_cast<DeadlineTask*>(arg);
+
+    while (true)
+    {
+        task.loop();
+
+        waitUntil(task.nextDeadline());
+    }
+}
+
 } // namespace
 
-cpputils::ArrayView<SchedulerTask> tasks{tasksArray};
+cpputils::ArrayView<DeadlineTask> tasks{tasksArray};
+
+void sched_begin()
+{
+    // setup keeps the table order, even for tasks that loop on their own later
+    for (auto& task : tasks)
+    {
+        task.setup();
+    }
+
+    for (auto& task : tasks)
+    {
+        if (!taskplacement::get(task.name()).ownTask)
+        {
+            continue;
+        }
+
+        TaskHandle_t handle{};
+
+        if (const auto result = taskplacement::createTask(own_task, task.name(), &task, &handle); result != pdPASS)
+        {
+            ESP_LOGE(TAG, "failed creating task for %s %d, keeping it in app_main", task.name(), result);
+            continue;
+        }
+
+        task.setTaskHandle(handle);
+    }
+}
+
+void sched_loop()
+{
+    for (auto& task : tasks)
+    {
+        if (task.taskHandle())
+        {
+            continue;
+        }
+
+        task.loop();
+
+#if defined(CONFIG_ESP_TASK_WDT_PANIC) || defined(CONFIG_ESP_TASK_WDT)
+        if (const auto result = esp_task_wdt_reset(); result != ESP_OK)
+            ESP_LOGE(TAG, "esp_task_wdt_reset() failed with %s", esp_err_to_name(result));
+#endif
+    }
+}
 
 void sched_pushStats(const bool printTasks)
 {
@@ -63,3 +152,55 @@ void sched_pushStats(const bool printTasks)
     if (printTasks)
         ESP_LOGI(TAG, "end listing tasks. total sum of all tasks: %ims", totalMillis);
 }
+
+espchrono::millis_clock::time_point sched_nextDeadline()
+{
+    auto deadline = espchrono::millis_clock::time_point::max();
+
+    for (const auto& task : tasks)
+    {
+        if (!task.taskHandle())
+        {
+            deadline = std::min(deadline, task.nextDeadline());
+        }
+    }
+
+    return deadline;
+}
+
+void sched_waitUntil(const espchrono::millis_clock::time_point deadline)
+{
+    schedulerTask.store(xTaskGetCurrentTaskHandle(), std::memory_order_relaxed);
+
+    waitUntil(deadline);
+}
+
+void sched_wakeup(const char* taskName)
+{
+    if (taskName)
+    {
+        const auto task = std::find_if(tasks.begin(), tasks.end(), [taskName](const DeadlineTask& task) {
+            return std::string_view{task.name()} == taskName;
+        });
+
+        if (task == tasks.end())
+        {
+            ESP_LOGW(TAG, "sched_wakeup(): unknown task %s", taskName);
+        }
+        else
+        {
+            task->requestRun();
+
+            if (const auto handle = task->taskHandle())
+            {
+                xTaskNotifyGive(handle);
+                return;
+            }
+        }
+    }
+
+    if (const auto handle = schedulerTask.load(std::memory_order_relaxed))
+    {
+        xTaskNotifyGive(handle);
+    }
+}
@@ -2,8 +2,26 @@
 
 // 3rdparty lib includes
 #include <arrayview.h>
-#include <schedulertask.h>
+#include <espchrono.h>
 
-extern cpputils::ArrayView<espcpputils::SchedulerTask> tasks;
+// local includes
+#include "utils/deadlinetask.h"
+
+extern cpputils::ArrayView<DeadlineTask> tasks;
+
+// runs the setup of every task and starts the ones placed in a task of their own
+void sched_begin();
+
+// runs the tasks of the app_main loop that are due
+void sched_loop();
 
 void sched_pushStats(bool printTasks);
+
+// earliest deadline of the tasks in the app_main loop
+espchrono::millis_clock::time_point sched_nextDeadline();
+
+// blocks the scheduler loop until deadline or until sched_wakeup() is called
+void sched_waitUntil(espchrono::millis_clock::time_point deadline);
+
+// wakes the scheduler loop early, with a task name that task runs right away
+void sched_wakeup(const char* taskName = nullptr);
@@ -61,6 +61,7 @@ const char *t_to_str<T>::str = "unknown";
     x(espchrono::seconds32) \
     x(SecondaryBrightnessMode) \
     x(LedAnimationName) \
+    x(DigitTransition) \
     x(cpputils::ColorHelper)
 
 #define DEFINE_FOR_TYPE(TYPE) DEFINE_FOR_TYPE2(TYPE, TYPE)
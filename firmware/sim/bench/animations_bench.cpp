@@ -0,0 +1,150 @@
+// Cost of the animations per frame through the real render path: the AnimationUpdate and Render
+// stage histograms the device reports in /api/v1/perf, plus the whole frame as seen from outside.
+//
+// The procedural animations have to stay below 500us per frame for 232 leds on the 240 MHz core,
+// they share it with wifi and http. The host gate divides that by 50, 12.5x for the clock and 4x
+// for the wider desktop core, and fails the run above it.
+
+// system includes
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <optional>
+#include <string_view>
+
+// local includes
+#include "bench.h"
+#include "simulator.h"
+#include "utils/config.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Case
+{
+    std::string_view name;
+    LedAnimationName animation;
+    // effect program for CustomEffect, unset keeps the default
+    std::optional<std::string_view> program{};
+    bool gated{};
+};
+
+constexpr double deviceBudgetMicroseconds = 500;
+constexpr double hostBudgetMicroseconds = deviceBudgetMicroseconds / 50;
+
+// longer than every update interval, so each frame updates and renders the animation
+constexpr auto frameStep = 50ms;
+
+// per led: hue from a sine over position and time, value from the segment being lit
+constexpr std::string_view perLedSineProgram = "0100" "12" "13" "0340" "22" "20" "2a" "0380" "22" "0380" "20" "0201" "16" "41";
+
+constexpr Case cases[]{
+    {"Rainbow", LedAnimationName::Rainbow},
+    {"CustomEffect, default gradient", LedAnimationName::CustomEffect},
+    {"CustomEffect, per led sine", LedAnimationName::CustomEffect, perLedSineProgram},
+    {"Fire", LedAnimationName::Fire, std::nullopt, true},
+    {"Plasma", LedAnimationName::Plasma, std::nullopt, true},
+    {"Noise", LedAnimationName::Noise, std::nullopt, true},
+    {"Twinkle", LedAnimationName::Twinkle, std::nullopt, true},
+};
+
+uint64_t stageSum(const RenderStage stage)
+{
+    return ledmanager::renderStats().stages[static_cast<size_t>(stage)].sum();
+}
+
+uint32_t stageCount(const RenderStage stage)
+{
+    return ledmanager::renderStats().stages[static_cast<size_t>(stage)].count();
+}
+
+struct Result
+{
+    double animationMicroseconds;
+    double frameMicroseconds;
+};
+
+std::optional<Result> measure(const Case& benchCase, const size_t frames)
+{
+    if (benchCase.program)
+    {
+        if (const auto result = configutils::write_config(configs.customEffect, std::string{*benchCase.program}); !result)
+        {
+            std::fprintf(stderr, "%s: %s\n", benchCase.name.data(), result.error().c_str());
+            return std::nullopt;
+        }
+    }
+
+    if (const auto result = configutils::write_config(configs.ledAnimation, benchCase.animation); !result)
+    {
+        std::fprintf(stderr, "%s: %s\n", benchCase.name.data(), result.error().c_str());
+        return std::nullopt;
+    }
+
+    // switch over and let the animation settle
+    for (int i = 0; i < 10; ++i)
+        sim::step(frameStep);
+
+    const auto updateSum = stageSum(RenderStage::AnimationUpdate);
+    const auto renderSum = stageSum(RenderStage::Render);
+    const auto renderCount = stageCount(RenderStage::Render);
+
+    const auto frameNanoseconds = bench::nanosecondsPerCall([] { sim::step(frameStep); }, frames, 1);
+
+    const auto rendered = stageCount(RenderStage::Render) - renderCount;
+    if (!rendered)
+        return std::nullopt;
+
+    const auto animationSum = (stageSum(RenderStage::AnimationUpdate) - updateSum) + (stageSum(RenderStage::Render) - renderSum);
+
+    return Result{static_cast<double>(animationSum) / rendered, frameNanoseconds / 1000};
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    // enough frames for the histograms' whole microseconds to average out, even with --quick
+    const auto frames = std::max<size_t>(bench::iterations(argc, argv, 4000), 200);
+
+    sim::begin();
+
+    // cut straight to the next animation instead of cross-fading
+    configutils::write_config(configs.animationTransitionDuration, 0);
+
+    std::printf("animations, %d leds, us per frame\n", HARDWARE_WS2812B_COUNT);
+    std::printf("  %-40s %12s %12s %10s %8s\n", "case", "animation", "frame", "vs first", "budget");
+
+    std::optional<double> baseline;
+    bool overBudget{};
+
+    for (const auto& benchCase : cases)
+    {
+        // like bench::nanosecondsPerCall(), the least disturbed of a few runs counts
+        std::optional<Result> result;
+        for (int repetition = 0; repetition < 3; ++repetition)
+        {
+            const auto run = measure(benchCase, frames);
+            if (!run)
+                return 1;
+
+            if (!result || run->animationMicroseconds < result->animationMicroseconds)
+                result = run;
+        }
+
+        if (!baseline)
+            baseline = result->animationMicroseconds;
+
+        const auto exceeded = benchCase.gated && result->animationMicroseconds > hostBudgetMicroseconds;
+        overBudget |= exceeded;
+
+        std::printf("  %-40.*s %12.2f %12.2f %9.2fx %8s\n", static_cast<int>(benchCase.name.size()), benchCase.name.data(),
+                    result->animationMicroseconds, result->frameMicroseconds,
+                    result->animationMicroseconds / *baseline, !benchCase.gated ? "" : exceeded ? "OVER" : "ok");
+    }
+
+    std::printf("  budget: %.0fus on the device, %.0fus on the host\n", deviceBudgetMicroseconds, hostBudgetMicroseconds);
+
+    return overBudget ? 1 : 0;
+}
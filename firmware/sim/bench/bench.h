@@ -0,0 +1,72 @@
+#pragma once
+
+// system includes
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <optional>
+#include <string_view>
+
+// Minimal timing helpers for the host benchmarks. Every case runs a few repetitions and keeps the
+// fastest one, which is the least disturbed by the rest of the host. Numbers are host numbers,
+// an ESP32 at 240 MHz is roughly an order of magnitude slower.
+namespace bench {
+
+template<typename T>
+inline void doNotOptimize(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// --quick only checks that every case runs, for ctest
+inline size_t iterations(const int argc, char* argv[], const size_t full)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::string_view{argv[i]} == "--quick")
+            return 1;
+    }
+
+    return full;
+}
+
+// fastest of the repetitions, in nanoseconds per call of function
+template<typename Function>
+double nanosecondsPerCall(Function&& function, const size_t iterations, const size_t repetitions = 5)
+{
+    double best{};
+
+    for (size_t repetition = 0; repetition < repetitions; ++repetition)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            function();
+        }
+
+        const std::chrono::duration<double, std::nano> elapsed{std::chrono::steady_clock::now() - start};
+        const auto perCall = elapsed.count() / iterations;
+
+        best = repetition == 0 ? perCall : std::min(best, perCall);
+    }
+
+    return best;
+}
+
+inline void header(const std::string_view title)
+{
+    std::printf("%.*s\n", static_cast<int>(title.size()), title.data());
+    std::printf("  %-40s %12s %10s\n", "case", "us/call", "speedup");
+}
+
+// baseline is the case the ratio refers to, unset for the baseline itself
+inline void report(const std::string_view name, const double nanoseconds, const std::optional<double> baseline = std::nullopt)
+{
+    if (baseline)
+        std::printf("  %-40.*s %12.3f %9.2fx\n", static_cast<int>(name.size()), name.data(), nanoseconds / 1000, *baseline / nanoseconds);
+    else
+        std::printf("  %-40.*s %12.3f %10s\n", static_cast<int>(name.size()), name.data(), nanoseconds / 1000, "base");
+}
+
+} // namespace bench
@@ -0,0 +1,86 @@
+// Animation cross-fade: the packed 32 bit blendLeds() against the same formula per channel and
+// against FastLED's blend() per pixel. The host vectorizes the plain loop, the device cannot.
+
+// system includes
+#include <cstdint>
+#include <string>
+
+// local includes
+#include "bench.h"
+#include "peripheral/ledhelpers/blend.h"
+#include "peripheral/ledmanager.h"
+
+namespace {
+
+using ledmanager::LedArray;
+
+inline void scalarBlend(const CRGB* from, const CRGB* to, CRGB* out, const size_t length, const uint16_t amount)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        for (size_t channel = 0; channel < 3; ++channel)
+        {
+            out[i].raw[channel] = (from[i].raw[channel] * (256 - amount) + to[i].raw[channel] * amount) >> 8;
+        }
+    }
+}
+
+// the ESP32 has no SIMD unit, this is closer to what the scalar loop costs there
+__attribute__((optimize("no-tree-vectorize")))
+void scalarBlendNotVectorized(const CRGB* from, const CRGB* to, CRGB* out, const size_t length, const uint16_t amount)
+{
+    scalarBlend(from, to, out, length, amount);
+}
+
+void fastledBlend(const CRGB* from, const CRGB* to, CRGB* out, const size_t length, const uint16_t amount)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        out[i] = blend(from[i], to[i], std::min<uint16_t>(amount, 255));
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const auto iterations = bench::iterations(argc, argv, 20000);
+
+    LedArray from, to, out;
+    uint8_t hue{};
+    for (size_t i = 0; i < from.size(); ++i)
+    {
+        from[i] = CHSV{hue, 255, 255};
+        to[i] = CHSV{static_cast<uint8_t>(hue + 128), 200, 160};
+        hue += 5;
+    }
+
+    bench::header("animation blend, " + std::to_string(from.size()) + " leds");
+
+    // the amount changes every frame during a transition
+    uint16_t amount{};
+    const auto next = [&amount] { return amount = (amount + 7) % 257; };
+
+    const auto baseline = bench::nanosecondsPerCall([&] {
+        fastledBlend(from.data(), to.data(), out.data(), out.size(), next());
+        bench::doNotOptimize(out);
+    }, iterations);
+    bench::report("FastLED blend() per pixel", baseline);
+
+    bench::report("scalar per channel", bench::nanosecondsPerCall([&] {
+        scalarBlend(from.data(), to.data(), out.data(), out.size(), next());
+        bench::doNotOptimize(out);
+    }, iterations), baseline);
+
+    bench::report("scalar per channel, not vectorized", bench::nanosecondsPerCall([&] {
+        scalarBlendNotVectorized(from.data(), to.data(), out.data(), out.size(), next());
+        bench::doNotOptimize(out);
+    }, iterations), baseline);
+
+    bench::report("blendLeds() packed words", bench::nanosecondsPerCall([&] {
+        blendLeds(from.data(), to.data(), out.data(), out.size(), next());
+        bench::doNotOptimize(out);
+    }, iterations), baseline);
+
+    return 0;
+}
@@ -0,0 +1,150 @@
+// Output stage (one 8.8 table per channel plus rounding or dithering) against what FastLED does
+// per pixel in show(): scale8 by correction times brightness, with its own dithering, and
+// napplyGamma_video() for gamma, which FastLED only offers as powf per channel value.
+
+// system includes
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+// local includes
+#include "bench.h"
+#include "peripheral/ledhelpers/outputstage.h"
+#include "peripheral/ledmanager.h"
+
+namespace {
+
+using ledmanager::LedArray;
+
+constexpr float outputGamma = 2.2f;
+constexpr uint8_t brightness = 180;
+const CRGB correction{TypicalSMD5050};
+
+// FastLED's applyGamma_video()
+uint8_t applyGammaVideo(const uint8_t value, const float exponent)
+{
+    const auto result = static_cast<uint8_t>(std::pow(value / 255.f, exponent) * 255.f);
+    return value > 0 && result == 0 ? 1 : result;
+}
+
+// FastLED's PixelController: the adjustment from computeAdjustment(), the binary dithering set up
+// per frame in init_binary_dithering() and stepped per pixel, then loadAndScale() per channel
+void fastledShowPath(const LedArray& in, LedArray& out, const bool dithering, uint8_t& frame)
+{
+    std::array<uint8_t, 3> scale, d{}, e{};
+    for (size_t channel = 0; channel < 3; ++channel)
+        scale[channel] = (uint32_t{correction.raw[channel]} * (brightness + 1)) >> 8;
+
+    if (dithering)
+    {
+        ++frame;
+
+        // 3 bit bit-reversed frame counter
+        uint8_t q = 0x10;
+        if (frame & 0x01) q |= 0x80;
+        if (frame & 0x02) q |= 0x40;
+        if (frame & 0x04) q |= 0x20;
+
+        for (size_t channel = 0; channel < 3; ++channel)
+        {
+            const uint8_t s = scale[channel];
+            e[channel] = s ? (256 / s) + 1 : 0;
+            d[channel] = scale8(q, e[channel]);
+            if (e[channel])
+                --e[channel];
+        }
+    }
+
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        for (size_t channel = 0; channel < 3; ++channel)
+        {
+            const uint8_t value = in[i].raw[channel];
+            out[i].raw[channel] = scale8(value ? qadd8(value, d[channel]) : 0, scale[channel]);
+        }
+
+        if (dithering)
+        {
+            for (size_t channel = 0; channel < 3; ++channel)
+                d[channel] = e[channel] - d[channel];
+        }
+    }
+}
+
+void gammaThenFastled(LedArray& pixels, LedArray& out, const bool dithering, uint8_t& frame)
+{
+    for (auto& pixel : pixels)
+    {
+        pixel.r = applyGammaVideo(pixel.r, outputGamma);
+        pixel.g = applyGammaVideo(pixel.g, outputGamma);
+        pixel.b = applyGammaVideo(pixel.b, outputGamma);
+    }
+
+    fastledShowPath(pixels, out, dithering, frame);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const auto iterations = bench::iterations(argc, argv, 20000);
+
+    LedArray frame;
+    uint8_t hue{};
+    for (auto& pixel : frame)
+    {
+        pixel = CHSV{hue, 255, 255};
+        hue += 3;
+    }
+
+    LedArray out;
+    uint8_t fastledFrame{};
+
+    OutputStage stage;
+    stage.setGamma(outputGamma);
+    stage.setCorrection(correction);
+    stage.setBrightness(brightness);
+
+    bench::header("output stage, " + std::to_string(frame.size()) + " leds, gamma 2.2");
+
+    const auto baseline = bench::nanosecondsPerCall([&] {
+        fastledShowPath(frame, out, false, fastledFrame);
+        bench::doNotOptimize(out);
+    }, iterations);
+    bench::report("FastLED scale8, no gamma", baseline);
+
+    auto gammaPixels = frame;
+    bench::report("FastLED napplyGamma_video + scale8", bench::nanosecondsPerCall([&] {
+        gammaPixels = frame;
+        gammaThenFastled(gammaPixels, out, false, fastledFrame);
+        bench::doNotOptimize(out);
+    }, iterations), baseline);
+
+    bench::report("FastLED scale8 + dither, no gamma", bench::nanosecondsPerCall([&] {
+        fastledShowPath(frame, out, true, fastledFrame);
+        bench::doNotOptimize(out);
+    }, iterations), baseline);
+
+    stage.setDithering(false);
+    bench::report("OutputStage LUT, rounded", bench::nanosecondsPerCall([&] {
+        stage.apply(frame.data(), out.data(), frame.size());
+        bench::doNotOptimize(out);
+    }, iterations), baseline);
+
+    stage.setDithering(true);
+    bench::report("OutputStage LUT, dithered", bench::nanosecondsPerCall([&] {
+        stage.apply(frame.data(), out.data(), frame.size());
+        bench::doNotOptimize(out);
+    }, iterations), baseline);
+
+    // brightness fades rebuild the scaled tables every frame
+    uint8_t fade{};
+    bench::report("OutputStage LUT, brightness changes", bench::nanosecondsPerCall([&] {
+        stage.setBrightness(++fade);
+        stage.apply(frame.data(), out.data(), frame.size());
+        bench::doNotOptimize(out);
+    }, iterations), baseline);
+
+    return 0;
+}
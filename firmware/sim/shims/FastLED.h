@@ -0,0 +1,202 @@
+#pragma once
+
+// Host stand-in for the part of FastLED the render path uses. The color math follows
+// FastLED (fixed scale8, fixed blend8, hsv2rgb_rainbow, HeatColor and the random8/16
+// generator), so frames match the device closely. Nothing is ever sent anywhere.
+
+// system includes
+#include <cstddef>
+#include <cstdint>
+
+// esp-idf includes
+#include <driver/gpio.h>
+
+typedef uint8_t fract8;
+
+constexpr uint8_t qadd8(const uint8_t i, const uint8_t j)
+{
+    const unsigned sum = i + j;
+    return sum > 255 ? 255 : sum;
+}
+
+constexpr uint8_t qsub8(const uint8_t i, const uint8_t j)
+{
+    const int difference = i - j;
+    return difference < 0 ? 0 : difference;
+}
+
+constexpr uint8_t scale8(const uint8_t i, const fract8 scale)
+{
+    return (uint16_t{i} * (1 + uint16_t{scale})) >> 8;
+}
+
+constexpr uint8_t scale8_video(const uint8_t i, const fract8 scale)
+{
+    return ((i * scale) >> 8) + ((i && scale) ? 1 : 0);
+}
+
+constexpr uint8_t blend8(const uint8_t a, const uint8_t b, const uint8_t amountOfB)
+{
+    uint16_t partial = (a << 8) | b;
+    partial += b * amountOfB;
+    partial -= a * amountOfB;
+    return partial >> 8;
+}
+
+uint8_t random8();
+uint8_t random8(uint8_t lim);
+uint8_t random8(uint8_t min, uint8_t lim);
+
+uint16_t random16();
+uint16_t random16(uint16_t lim);
+
+void random16_set_seed(uint16_t seed);
+
+enum LEDColorCorrection : uint32_t
+{
+    TypicalSMD5050 = 0xFFB0F0,
+    TypicalLEDStrip = 0xFFB0F0,
+    Typical8mmPixel = 0xFFE08C,
+    TypicalPixelString = 0xFFE08C,
+    UncorrectedColor = 0xFFFFFF,
+};
+
+struct CHSV
+{
+    uint8_t hue{};
+    uint8_t sat{};
+    uint8_t val{};
+
+    CHSV() = default;
+
+    constexpr CHSV(const uint8_t h, const uint8_t s, const uint8_t v) : hue{h}, sat{s}, val{v} {}
+};
+
+struct CRGB;
+
+void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb);
+
+struct CRGB
+{
+    union {
+        struct {
+            union { uint8_t r; uint8_t red; };
+            union { uint8_t g; uint8_t green; };
+            union { uint8_t b; uint8_t blue; };
+        };
+        uint8_t raw[3];
+    };
+
+    enum HTMLColorCode : uint32_t
+    {
+        Black = 0x000000,
+        Blue = 0x0000FF,
+        Green = 0x008000,
+        Orange = 0xFFA500,
+        Purple = 0x800080,
+        Red = 0xFF0000,
+        White = 0xFFFFFF,
+        Yellow = 0xFFFF00,
+    };
+
+    CRGB() = default;
+
+    constexpr CRGB(const uint8_t ir, const uint8_t ig, const uint8_t ib) : r{ir}, g{ig}, b{ib} {}
+
+    constexpr CRGB(const uint32_t colorcode) : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b(colorcode & 0xFF) {}
+
+    constexpr CRGB(const HTMLColorCode colorcode) : CRGB{static_cast<uint32_t>(colorcode)} {}
+
+    constexpr CRGB(const LEDColorCorrection colorcode) : CRGB{static_cast<uint32_t>(colorcode)} {}
+
+    CRGB(const CHSV& hsv) { hsv2rgb_rainbow(hsv, *this); }
+
+    constexpr uint8_t& operator[](const size_t index) { return raw[index]; }
+
+    constexpr const uint8_t& operator[](const size_t index) const { return raw[index]; }
+
+    constexpr CRGB& operator+=(const CRGB& rhs)
+    {
+        r = qadd8(r, rhs.r);
+        g = qadd8(g, rhs.g);
+        b = qadd8(b, rhs.b);
+        return *this;
+    }
+
+    constexpr CRGB& nscale8(const uint8_t scale)
+    {
+        r = scale8(r, scale);
+        g = scale8(g, scale);
+        b = scale8(b, scale);
+        return *this;
+    }
+
+    constexpr CRGB& nscale8_video(const uint8_t scale)
+    {
+        r = scale8_video(r, scale);
+        g = scale8_video(g, scale);
+        b = scale8_video(b, scale);
+        return *this;
+    }
+};
+
+constexpr bool operator==(const CRGB& lhs, const CRGB& rhs)
+{
+    return lhs.r == rhs.r && lhs.g == rhs.g && lhs.b == rhs.b;
+}
+
+constexpr bool operator!=(const CRGB& lhs, const CRGB& rhs)
+{
+    return !(lhs == rhs);
+}
+
+CRGB& nblend(CRGB& existing, const CRGB& overlay, fract8 amountOfOverlay);
+
+CRGB blend(const CRGB& p1, const CRGB& p2, fract8 amountOfP2);
+
+void fill_solid(CRGB* leds, int numToFill, const CRGB& color);
+
+void fill_rainbow(CRGB* leds, int numToFill, uint8_t initialhue, uint8_t deltahue = 5);
+
+CRGB HeatColor(uint8_t temperature);
+
+enum EOrder { RGB, RBG, GRB, GBR, BRG, BGR };
+
+template<uint8_t DataPin, EOrder Order>
+class WS2812B {};
+
+class CFastLED
+{
+public:
+    template<template<uint8_t, EOrder> class Chipset, uint8_t DataPin, EOrder Order>
+    void addLeds(CRGB* leds, const int count)
+    {
+        m_leds = leds;
+        m_count = count;
+    }
+
+    void setBrightness(const uint8_t scale) { m_brightness = scale; }
+
+    uint8_t getBrightness() const { return m_brightness; }
+
+    void setCorrection(const CRGB&) {}
+
+    void setDither(uint8_t) {}
+
+    void clear();
+
+    // counts the frames instead of sending them
+    void show() { ++m_shown; }
+
+    uint16_t getFPS() const { return 0; }
+
+    uint32_t shownFrames() const { return m_shown; }
+
+private:
+    CRGB* m_leds{};
+    int m_count{};
+    uint8_t m_brightness{255};
+    uint32_t m_shown{};
+};
+
+extern CFastLED FastLED;
@@ -0,0 +1,11 @@
+#pragma once
+
+// system includes
+#include <span>
+
+namespace cpputils {
+
+template<typename T>
+using ArrayView = std::span<T>;
+
+} // namespace cpputils
@@ -0,0 +1,29 @@
+#pragma once
+
+// system includes
+#include <utility>
+
+namespace cpputils {
+
+template<typename T>
+class CleanupHelper
+{
+public:
+    explicit CleanupHelper(T&& callback) : m_callback{std::move(callback)} {}
+
+    CleanupHelper(const CleanupHelper&) = delete;
+    CleanupHelper& operator=(const CleanupHelper&) = delete;
+
+    ~CleanupHelper() { m_callback(); }
+
+private:
+    T m_callback;
+};
+
+template<typename T>
+CleanupHelper<T> makeCleanupHelper(T&& callback)
+{
+    return CleanupHelper<T>{std::forward<T>(callback)};
+}
+
+} // namespace cpputils
@@ -0,0 +1,20 @@
+#pragma once
+
+// system includes
+#include <cstdint>
+
+namespace cpputils {
+
+struct ColorHelper
+{
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+
+    friend constexpr bool operator==(const ColorHelper&, const ColorHelper&) = default;
+};
+
+constexpr ColorHelper white{255, 255, 255};
+constexpr ColorHelper black{0, 0, 0};
+
+} // namespace cpputils
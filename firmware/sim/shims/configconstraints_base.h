@@ -0,0 +1,53 @@
+#pragma once
+
+// system includes
+#include <format>
+#include <string>
+
+// 3rdparty lib includes
+#include <configwrapper.h>
+
+namespace espconfig {
+
+inline ConfigConstraintReturnType StringEmpty(const std::string& str)
+{
+    if (!str.empty())
+        return std::unexpected("String has to be empty");
+
+    return {};
+}
+
+template<size_t MIN_LENGTH, size_t MAX_LENGTH>
+ConfigConstraintReturnType StringMinMaxSize(const std::string& str)
+{
+    if (str.size() < MIN_LENGTH || str.size() > MAX_LENGTH)
+        return std::unexpected(std::format("String length {} exceeds range {} to {}", str.size(), MIN_LENGTH, MAX_LENGTH));
+
+    return {};
+}
+
+template<size_t MAX_LENGTH>
+ConfigConstraintReturnType StringMaxSize(const std::string& str)
+{
+    return StringMinMaxSize<0, MAX_LENGTH>(str);
+}
+
+template<ConfigConstraintReturnType (*A)(const std::string&), ConfigConstraintReturnType (*B)(const std::string&)>
+ConfigConstraintReturnType StringOr(const std::string& str)
+{
+    if (auto result = A(str); result)
+        return result;
+
+    return B(str);
+}
+
+template<typename T, T MIN, T MAX>
+ConfigConstraintReturnType MinMaxValue(const T value)
+{
+    if (value < MIN || value > MAX)
+        return std::unexpected(std::format("Value {} exceeds range {} to {}", value, MIN, MAX));
+
+    return {};
+}
+
+} // namespace espconfig
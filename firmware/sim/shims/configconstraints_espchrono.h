@@ -0,0 +1,17 @@
+#pragma once
+
+// 3rdparty lib includes
+#include <configwrapper.h>
+#include <espchrono.h>
+
+namespace espconfig {
+
+inline ConfigConstraintReturnType MinTimeSyncInterval(const espchrono::milliseconds32 value)
+{
+    if (value < espchrono::milliseconds32{15000})
+        return std::unexpected("Sync interval has to be at least 15 seconds");
+
+    return {};
+}
+
+} // namespace espconfig
@@ -0,0 +1,22 @@
+#pragma once
+
+// system includes
+#include <utility>
+
+// 3rdparty lib includes
+#include <configwrapper.h>
+
+namespace espconfig {
+
+template<typename ConfigContainer>
+class ConfigManager : public ConfigContainer
+{
+public:
+    template<typename T, typename V>
+    ConfigConstraintReturnType write_config(ConfigWrapper<T>& config, V&& value)
+    {
+        return config.write(T(std::forward<V>(value)));
+    }
+};
+
+} // namespace espconfig
@@ -0,0 +1,63 @@
+#pragma once
+
+// system includes
+#include <expected>
+#include <optional>
+#include <string>
+#include <utility>
+
+// 3rdparty lib includes
+#include <cppmacros.h>
+
+// Host stand-in for espconfiglib. Values live in memory and start out at their default,
+// nothing is read from or written to nvs.
+
+using ConfigConstraintReturnType = std::expected<void, std::string>;
+
+class ConfigWrapperInterface
+{
+public:
+    virtual ~ConfigWrapperInterface() = default;
+
+    virtual const char* nvsName() const = 0;
+
+    virtual bool allowReset() const = 0;
+};
+
+template<typename T>
+class ConfigWrapper : public ConfigWrapperInterface
+{
+public:
+    using value_t = T;
+    using ConstraintCallback = ConfigConstraintReturnType (*)(const T&);
+
+    ConfigWrapper() = default;
+
+    CPP_DISABLE_COPY_MOVE(ConfigWrapper)
+
+    virtual T defaultValue() const = 0;
+
+    virtual ConfigConstraintReturnType checkValue(value_t value) const = 0;
+
+    // the default is only known once the derived wrapper is constructed
+    const T& value() const
+    {
+        if (!m_value)
+            m_value = defaultValue();
+
+        return *m_value;
+    }
+
+    ConfigConstraintReturnType write(T value)
+    {
+        if (auto result = checkValue(value); !result)
+            return result;
+
+        m_value = std::move(value);
+
+        return {};
+    }
+
+private:
+    mutable std::optional<T> m_value;
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+#define CPP_DISABLE_COPY(Class) \
+    Class(const Class&) = delete; \
+    Class& operator=(const Class&) = delete;
+
+#define CPP_DISABLE_MOVE(Class) \
+    Class(Class&&) = delete; \
+    Class& operator=(Class&&) = delete;
+
+#define CPP_DISABLE_COPY_MOVE(Class) \
+    CPP_DISABLE_COPY(Class) \
+    CPP_DISABLE_MOVE(Class)
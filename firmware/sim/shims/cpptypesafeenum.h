@@ -0,0 +1,35 @@
+#pragma once
+
+// system includes
+#include <expected>
+#include <string>
+#include <string_view>
+
+#define TYPESAFE_ENUM_VALUE(name) name,
+#define TYPESAFE_ENUM_TO_STRING(name) case TheEnum::name: return #name;
+#define TYPESAFE_ENUM_PARSE(name) if (str == #name) return TheEnum::name;
+#define TYPESAFE_ENUM_ITERATE(name) callback(TheEnum::name, #name);
+
+#define DECLARE_GLOBAL_TYPESAFE_ENUM(Name, Derivation, Values) \
+    enum class Name Derivation { Values(TYPESAFE_ENUM_VALUE) }; \
+    inline std::string toString(const Name value) \
+    { \
+        using TheEnum = Name; \
+        switch (value) \
+        { \
+        Values(TYPESAFE_ENUM_TO_STRING) \
+        } \
+        return "Unknown " #Name "(" + std::to_string(static_cast<int>(value)) + ")"; \
+    } \
+    inline std::expected<Name, std::string> parse##Name(const std::string_view str) \
+    { \
+        using TheEnum = Name; \
+        Values(TYPESAFE_ENUM_PARSE) \
+        return std::unexpected("invalid " #Name " (" + std::string{str} + ")"); \
+    } \
+    template<typename T> \
+    void iterate##Name(T&& callback) \
+    { \
+        using TheEnum = Name; \
+        Values(TYPESAFE_ENUM_ITERATE) \
+    }
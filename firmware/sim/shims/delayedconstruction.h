@@ -0,0 +1,32 @@
+#pragma once
+
+// system includes
+#include <optional>
+#include <utility>
+
+namespace cpputils {
+
+template<typename T>
+class DelayedConstruction
+{
+public:
+    template<typename... Args>
+    void construct(Args&&... args) { m_value.emplace(std::forward<Args>(args)...); }
+
+    void destruct() { m_value.reset(); }
+
+    bool constructed() const { return m_value.has_value(); }
+
+    explicit operator bool() const { return constructed(); }
+
+    T* operator->() { return &*m_value; }
+    const T* operator->() const { return &*m_value; }
+
+    T& operator*() { return *m_value; }
+    const T& operator*() const { return *m_value; }
+
+private:
+    std::optional<T> m_value;
+};
+
+} // namespace cpputils
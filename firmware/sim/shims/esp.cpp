@@ -0,0 +1,95 @@
+// system includes
+#include <chrono>
+
+// esp-idf includes
+#include <esp_log.h>
+#include <esp_timer.h>
+
+// 3rdparty lib includes
+#include <espchrono.h>
+#include <taskutils.h>
+
+// local includes
+#include "simclock.h"
+
+esp_log_level_t sim_log_level = ESP_LOG_WARN;
+
+namespace simclock {
+
+namespace {
+
+// millis_clock does not start at 0 on the device either
+std::chrono::milliseconds millisNow{12345};
+
+// wall clock at millisNow
+std::chrono::sys_time<std::chrono::milliseconds> localNow{std::chrono::sys_days{std::chrono::year{2024} / 6 / 15} + std::chrono::hours{12}};
+
+} // namespace
+
+void setLocalTime(const std::chrono::sys_time<std::chrono::milliseconds> localTime)
+{
+    localNow = localTime;
+}
+
+void advance(const std::chrono::milliseconds duration)
+{
+    millisNow += duration;
+    localNow += duration;
+}
+
+std::chrono::milliseconds millis()
+{
+    return millisNow;
+}
+
+} // namespace simclock
+
+namespace espchrono {
+
+millis_clock::time_point millis_clock::now() noexcept
+{
+    return time_point{simclock::millis()};
+}
+
+local_clock::time_point local_clock::now() noexcept
+{
+    return time_point{simclock::localNow.time_since_epoch()};
+}
+
+utc_clock::time_point utc_clock::now() noexcept
+{
+    // the simulator does not model a time zone, local time doubles as utc
+    return time_point{simclock::localNow.time_since_epoch()};
+}
+
+} // namespace espchrono
+
+int64_t esp_timer_get_time()
+{
+    static const auto start = std::chrono::steady_clock::now();
+
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t*, esp_timer_handle_t* handle)
+{
+    static int dummy;
+
+    *handle = reinterpret_cast<esp_timer_handle_t>(&dummy);
+
+    return ESP_OK;
+}
+
+namespace espcpputils {
+
+BaseType_t createTask(TaskFunction_t, const char*, uint32_t, void*, UBaseType_t, TaskHandle_t* handle, CoreAffinity)
+{
+    static int dummy;
+
+    if (handle)
+        *handle = reinterpret_cast<TaskHandle_t>(&dummy);
+
+    return pdPASS;
+}
+
+} // namespace espcpputils
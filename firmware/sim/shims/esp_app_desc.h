@@ -0,0 +1,15 @@
+#pragma once
+
+// system includes
+#include <cstdint>
+
+typedef struct {
+    uint32_t magic_word;
+    uint32_t secure_version;
+    char version[32];
+    char project_name[32];
+    char time[16];
+    char date[16];
+    char idf_ver[32];
+    uint8_t app_elf_sha256[32];
+} esp_app_desc_t;
@@ -0,0 +1,8 @@
+#pragma once
+
+typedef int esp_err_t;
+
+constexpr esp_err_t ESP_OK = 0;
+constexpr esp_err_t ESP_FAIL = -1;
+
+inline const char* esp_err_to_name(const esp_err_t code) { return code == ESP_OK ? "ESP_OK" : "ESP_FAIL"; }
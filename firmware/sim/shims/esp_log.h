@@ -0,0 +1,28 @@
+#pragma once
+
+// system includes
+#include <cstdio>
+
+typedef enum {
+    ESP_LOG_NONE,
+    ESP_LOG_ERROR,
+    ESP_LOG_WARN,
+    ESP_LOG_INFO,
+    ESP_LOG_DEBUG,
+    ESP_LOG_VERBOSE,
+} esp_log_level_t;
+
+// lines above this level are dropped, warnings by default so frame dumps stay readable
+extern esp_log_level_t sim_log_level;
+
+#define SIM_LOG(level, letter, tag, format, ...) \
+    do { \
+        if (level <= sim_log_level) \
+            std::fprintf(stderr, letter " (%s) " format "\n", tag __VA_OPT__(,) __VA_ARGS__); \
+    } while (false)
+
+#define ESP_LOGE(tag, format, ...) SIM_LOG(ESP_LOG_ERROR, "E", tag, format __VA_OPT__(,) __VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) SIM_LOG(ESP_LOG_WARN, "W", tag, format __VA_OPT__(,) __VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) SIM_LOG(ESP_LOG_INFO, "I", tag, format __VA_OPT__(,) __VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) SIM_LOG(ESP_LOG_DEBUG, "D", tag, format __VA_OPT__(,) __VA_ARGS__)
+#define ESP_LOGV(tag, format, ...) SIM_LOG(ESP_LOG_VERBOSE, "V", tag, format __VA_OPT__(,) __VA_ARGS__)
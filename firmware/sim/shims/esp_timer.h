@@ -0,0 +1,34 @@
+#pragma once
+
+// system includes
+#include <cstdint>
+
+// esp-idf includes
+#include <esp_err.h>
+
+// real monotonic microseconds, the stage timings and histograms measure the host
+int64_t esp_timer_get_time();
+
+typedef void (*esp_timer_cb_t)(void* arg);
+
+typedef enum {
+    ESP_TIMER_TASK,
+    ESP_TIMER_ISR,
+} esp_timer_dispatch_t;
+
+typedef struct {
+    esp_timer_cb_t callback;
+    void* arg;
+    esp_timer_dispatch_t dispatch_method;
+    const char* name;
+    bool skip_unhandled_events;
+} esp_timer_create_args_t;
+
+typedef struct esp_timer* esp_timer_handle_t;
+
+// timers never fire, the simulator renders frames itself
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* handle);
+
+inline esp_err_t esp_timer_start_once(esp_timer_handle_t, uint64_t) { return ESP_OK; }
+
+inline esp_err_t esp_timer_stop(esp_timer_handle_t) { return ESP_OK; }
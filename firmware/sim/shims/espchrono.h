@@ -0,0 +1,117 @@
+#pragma once
+
+// system includes
+#include <chrono>
+#include <cstdint>
+
+// Host stand-in for espchrono. All clocks run on the simulated time of simclock.h, so a
+// headless run renders the same frames no matter how fast the host is.
+
+namespace date {
+
+using std::chrono::day;
+using std::chrono::month;
+using std::chrono::year;
+using std::chrono::year_month_day;
+
+} // namespace date
+
+namespace espchrono {
+
+using milliseconds32 = std::chrono::duration<int32_t, std::milli>;
+using seconds32 = std::chrono::duration<int32_t>;
+using minutes32 = std::chrono::duration<int32_t, std::ratio<60>>;
+using hours32 = std::chrono::duration<int32_t, std::ratio<3600>>;
+
+enum class DayLightSavingMode { None, EuropeanSummerTime, UsDaylightTime };
+
+struct time_zone
+{
+    minutes32 offset{};
+    DayLightSavingMode dayLightSavingMode{};
+};
+
+struct millis_clock
+{
+    using duration = std::chrono::milliseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<millis_clock, duration>;
+
+    static constexpr bool is_steady = true;
+
+    static time_point now() noexcept;
+};
+
+struct utc_clock
+{
+    using duration = std::chrono::milliseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<utc_clock, duration>;
+
+    static constexpr bool is_steady = false;
+
+    static time_point now() noexcept;
+};
+
+// wall clock time in the configured time zone, the simulator sets it directly
+struct local_clock
+{
+    using duration = std::chrono::milliseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<local_clock, duration>;
+
+    static constexpr bool is_steady = false;
+
+    static time_point now() noexcept;
+};
+
+using local_time_point = local_clock::time_point;
+
+struct DateTime
+{
+    date::year_month_day date{};
+
+    uint8_t hour{};
+    uint8_t minute{};
+    uint8_t second{};
+    uint16_t millisecond{};
+};
+
+template<typename Clock>
+DateTime toDateTime(const typename Clock::time_point& timePoint)
+{
+    const std::chrono::sys_time<std::chrono::milliseconds> sys{timePoint.time_since_epoch()};
+    const auto days = std::chrono::floor<std::chrono::days>(sys);
+    const std::chrono::hh_mm_ss time{sys - days};
+
+    return DateTime{
+        .date = date::year_month_day{days},
+        .hour = static_cast<uint8_t>(time.hours().count()),
+        .minute = static_cast<uint8_t>(time.minutes().count()),
+        .second = static_cast<uint8_t>(time.seconds().count()),
+        .millisecond = static_cast<uint16_t>(time.subseconds().count()),
+    };
+}
+
+inline DateTime toDateTime(const utc_clock::time_point& timePoint) { return toDateTime<utc_clock>(timePoint); }
+
+inline DateTime toDateTime(const local_clock::time_point& timePoint) { return toDateTime<local_clock>(timePoint); }
+
+inline local_clock::time_point fromDateTime(const DateTime& dateTime)
+{
+    const std::chrono::sys_days days{dateTime.date};
+
+    return local_clock::time_point{days.time_since_epoch() + std::chrono::hours{dateTime.hour} + std::chrono::minutes{dateTime.minute} +
+                                   std::chrono::seconds{dateTime.second} + std::chrono::milliseconds{dateTime.millisecond}};
+}
+
+template<typename Clock, typename Duration>
+typename Clock::duration ago(const std::chrono::time_point<Clock, Duration>& timePoint)
+{
+    return Clock::now() - timePoint;
+}
+
+} // namespace espchrono
@@ -0,0 +1,32 @@
+#pragma once
+
+// system includes
+#include <array>
+#include <cstdint>
+
+typedef enum {
+    WIFI_AUTH_OPEN,
+    WIFI_AUTH_WEP,
+    WIFI_AUTH_WPA_PSK,
+    WIFI_AUTH_WPA2_PSK,
+    WIFI_AUTH_WPA_WPA2_PSK,
+} wifi_auth_mode_t;
+
+namespace wifi_stack {
+
+using mac_t = std::array<uint8_t, 6>;
+
+class ip_address_t
+{
+public:
+    constexpr ip_address_t() = default;
+
+    constexpr ip_address_t(const uint8_t a, const uint8_t b, const uint8_t c, const uint8_t d) : m_bytes{a, b, c, d} {}
+
+    friend constexpr bool operator==(const ip_address_t&, const ip_address_t&) = default;
+
+private:
+    std::array<uint8_t, 4> m_bytes{};
+};
+
+} // namespace wifi_stack
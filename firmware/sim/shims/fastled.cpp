@@ -0,0 +1,178 @@
+#include "FastLED.h"
+
+// system includes
+#include <algorithm>
+
+CFastLED FastLED;
+
+namespace {
+
+// same linear congruential generator and seed as FastLED, runs are reproducible
+uint16_t rand16seed = 1337;
+
+} // namespace
+
+uint8_t random8()
+{
+    rand16seed = (rand16seed * 2053) + 13849;
+
+    return static_cast<uint8_t>((rand16seed & 0xFF) + (rand16seed >> 8));
+}
+
+uint8_t random8(const uint8_t lim)
+{
+    return (random8() * lim) >> 8;
+}
+
+uint8_t random8(const uint8_t min, const uint8_t lim)
+{
+    return min + random8(lim - min);
+}
+
+uint16_t random16()
+{
+    rand16seed = (rand16seed * 2053) + 13849;
+
+    return rand16seed;
+}
+
+uint16_t random16(const uint16_t lim)
+{
+    return (uint32_t{random16()} * lim) >> 16;
+}
+
+void random16_set_seed(const uint16_t seed)
+{
+    rand16seed = seed;
+}
+
+void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb)
+{
+    const uint8_t hue = hsv.hue;
+    const uint8_t sat = hsv.sat;
+    uint8_t val = hsv.val;
+
+    const uint8_t offset8 = (hue & 0x1F) << 3;
+
+    const uint8_t third = scale8(offset8, 256 / 3);
+    const uint8_t twothirds = scale8(offset8, (256 * 2) / 3);
+
+    uint8_t r, g, b;
+
+    // eight sections of 32 hues each, yellow gets the gentle boost FastLED defaults to
+    switch (hue >> 5)
+    {
+    case 0: r = 255 - third; g = third; b = 0; break;
+    case 1: r = 171; g = 85 + third; b = 0; break;
+    case 2: r = 171 - twothirds; g = 170 + third; b = 0; break;
+    case 3: r = 0; g = 255 - third; b = third; break;
+    case 4: r = 0; g = 171 - twothirds; b = 85 + twothirds; break;
+    case 5: r = third; g = 0; b = 255 - third; break;
+    case 6: r = 85 + third; g = 0; b = 171 - third; break;
+    default: r = 170 + third; g = 0; b = 85 - third; break;
+    }
+
+    if (sat != 255)
+    {
+        if (sat == 0)
+        {
+            r = g = b = 255;
+        }
+        else
+        {
+            uint8_t desat = 255 - sat;
+            desat = scale8_video(desat, desat);
+
+            const uint8_t satscale = 255 - desat;
+
+            if (r) r = scale8(r, satscale) + 1;
+            if (g) g = scale8(g, satscale) + 1;
+            if (b) b = scale8(b, satscale) + 1;
+
+            r += desat;
+            g += desat;
+            b += desat;
+        }
+    }
+
+    if (val != 255)
+    {
+        val = scale8_video(val, val);
+
+        if (val == 0)
+        {
+            r = g = b = 0;
+        }
+        else
+        {
+            if (r) r = scale8(r, val) + 1;
+            if (g) g = scale8(g, val) + 1;
+            if (b) b = scale8(b, val) + 1;
+        }
+    }
+
+    rgb = CRGB{r, g, b};
+}
+
+CRGB& nblend(CRGB& existing, const CRGB& overlay, const fract8 amountOfOverlay)
+{
+    if (amountOfOverlay == 0)
+        return existing;
+
+    if (amountOfOverlay == 255)
+    {
+        existing = overlay;
+        return existing;
+    }
+
+    existing.r = blend8(existing.r, overlay.r, amountOfOverlay);
+    existing.g = blend8(existing.g, overlay.g, amountOfOverlay);
+    existing.b = blend8(existing.b, overlay.b, amountOfOverlay);
+
+    return existing;
+}
+
+CRGB blend(const CRGB& p1, const CRGB& p2, const fract8 amountOfP2)
+{
+    CRGB result{p1};
+    nblend(result, p2, amountOfP2);
+    return result;
+}
+
+void fill_solid(CRGB* leds, const int numToFill, const CRGB& color)
+{
+    std::fill_n(leds, numToFill, color);
+}
+
+void fill_rainbow(CRGB* leds, const int numToFill, const uint8_t initialhue, const uint8_t deltahue)
+{
+    CHSV hsv{initialhue, 240, 255};
+
+    for (int i = 0; i < numToFill; ++i)
+    {
+        leds[i] = hsv;
+        hsv.hue += deltahue;
+    }
+}
+
+CRGB HeatColor(const uint8_t temperature)
+{
+    // 0 to 191 in three ramps: black to red, red to yellow, yellow to white
+    const uint8_t t192 = scale8_video(temperature, 191);
+
+    const uint8_t heatramp = (t192 & 0x3F) << 2;
+
+    if (t192 & 0x80)
+        return CRGB{255, 255, heatramp};
+
+    if (t192 & 0x40)
+        return CRGB{255, heatramp, 0};
+
+    return CRGB{heatramp, 0, 0};
+}
+
+void CFastLED::clear()
+{
+    if (m_leds)
+        std::fill_n(m_leds, m_count, CRGB{CRGB::Black});
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+// system includes
+#include <cstdint>
+
+// the idf headers pull in logging everywhere, the firmware relies on that
+#include <esp_log.h>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+constexpr BaseType_t pdFALSE = 0;
+constexpr BaseType_t pdTRUE = 1;
+constexpr BaseType_t pdFAIL = 0;
+constexpr BaseType_t pdPASS = 1;
+
+constexpr TickType_t portMAX_DELAY = 0xFFFFFFFF;
+constexpr TickType_t portTICK_PERIOD_MS = 10;
+
+constexpr BaseType_t tskNO_AFFINITY = 0x7FFFFFFF;
@@ -0,0 +1,21 @@
+#pragma once
+
+// esp-idf includes
+#include <freertos/FreeRTOS.h>
+
+// Tasks are never started on the host, the simulator calls into the render path itself.
+// Handles are valid dummies and notifications go nowhere.
+
+typedef struct tskTaskControlBlock* TaskHandle_t;
+
+typedef void (*TaskFunction_t)(void*);
+
+inline BaseType_t xTaskNotifyGive(TaskHandle_t) { return pdPASS; }
+
+inline uint32_t ulTaskNotifyTake(BaseType_t, TickType_t) { return 0; }
+
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return nullptr; }
+
+inline void vTaskDelete(TaskHandle_t) {}
+
+inline void vTaskDelay(TickType_t) {}
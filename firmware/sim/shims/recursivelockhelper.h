@@ -0,0 +1,22 @@
+#pragma once
+
+// 3rdparty lib includes
+#include <wrappers/recursive_mutex_semaphore.h>
+
+namespace espcpputils {
+
+class RecursiveLockHelper
+{
+public:
+    explicit RecursiveLockHelper(SemaphoreHandle_t handle) : m_handle{handle} { m_handle->lock(); }
+
+    RecursiveLockHelper(const RecursiveLockHelper&) = delete;
+    RecursiveLockHelper& operator=(const RecursiveLockHelper&) = delete;
+
+    ~RecursiveLockHelper() { m_handle->unlock(); }
+
+private:
+    SemaphoreHandle_t m_handle;
+};
+
+} // namespace espcpputils
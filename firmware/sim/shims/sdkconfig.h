@@ -0,0 +1,5 @@
+#pragma once
+
+// the few options the render path and utils/config.h read, values from configs/sdkconfig_bme280
+#define CONFIG_WIFI_STA_CONFIG_COUNT 5
+#define CONFIG_LWIP_SNTP_UPDATE_DELAY 3600000
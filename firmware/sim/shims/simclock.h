@@ -0,0 +1,17 @@
+#pragma once
+
+// system includes
+#include <chrono>
+
+// Simulated time behind the espchrono shim. millis_clock starts at an arbitrary boot time,
+// local and utc clock advance together with it.
+namespace simclock {
+
+// sets the wall clock, millis_clock keeps counting from where it is
+void setLocalTime(std::chrono::sys_time<std::chrono::milliseconds> localTime);
+
+void advance(std::chrono::milliseconds duration);
+
+std::chrono::milliseconds millis();
+
+} // namespace simclock
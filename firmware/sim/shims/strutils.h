@@ -0,0 +1,5 @@
+#pragma once
+
+// system includes
+#include <string>
+#include <string_view>
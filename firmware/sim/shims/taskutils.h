@@ -0,0 +1,15 @@
+#pragma once
+
+// esp-idf includes
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace espcpputils {
+
+enum class CoreAffinity { Core0, Core1, Both };
+
+// hands out a dummy handle without running function
+BaseType_t createTask(TaskFunction_t function, const char* name, uint32_t stackSize, void* arg, UBaseType_t priority,
+                      TaskHandle_t* handle, CoreAffinity coreAffinity);
+
+} // namespace espcpputils
@@ -0,0 +1,23 @@
+#pragma once
+
+// system includes
+#include <mutex>
+
+// a std::recursive_mutex stands in for the FreeRTOS semaphore
+typedef std::recursive_mutex* SemaphoreHandle_t;
+
+namespace espcpputils {
+
+class recursive_mutex_semaphore
+{
+public:
+    recursive_mutex_semaphore() = default;
+
+    recursive_mutex_semaphore(const recursive_mutex_semaphore&) = delete;
+    recursive_mutex_semaphore& operator=(const recursive_mutex_semaphore&) = delete;
+
+    std::recursive_mutex mutex;
+    const SemaphoreHandle_t handle{&mutex};
+};
+
+} // namespace espcpputils
@@ -0,0 +1,209 @@
+// clock-sim: renders frames of the real led pipeline on a host and dumps them
+//
+//   clock-sim --frames 20 --animation Fire --time 13:37 --ascii
+//   clock-sim --frames 600 --raw frames.rgb
+
+// system includes
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string_view>
+
+// local includes
+#include "simulator.h"
+#include "utils/config.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Options
+{
+    int frames{1};
+    // 0 follows the frame interval the governor picks
+    std::chrono::milliseconds step{0};
+    std::optional<LedAnimationName> animation;
+    std::optional<std::chrono::minutes> time;
+    std::optional<std::string> text;
+    std::optional<std::string> raw;
+    bool ascii{};
+    bool color{};
+};
+
+void usage()
+{
+    std::fputs("usage: clock-sim [--frames N] [--step MS] [--animation NAME] [--time HH:MM] [--text TEXT]\n"
+               "                 [--raw FILE|-] [--ascii] [--color]\n", stderr);
+}
+
+std::optional<int> parseInt(const std::string_view str)
+{
+    int value{};
+    if (const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value); ec != std::errc{} || ptr != str.data() + str.size())
+        return std::nullopt;
+    return value;
+}
+
+std::optional<std::chrono::minutes> parseTime(const std::string_view str)
+{
+    const auto colon = str.find(':');
+    if (colon == std::string_view::npos)
+        return std::nullopt;
+
+    const auto hours = parseInt(str.substr(0, colon));
+    const auto minutes = parseInt(str.substr(colon + 1));
+    if (!hours || !minutes || *hours < 0 || *hours > 23 || *minutes < 0 || *minutes > 59)
+        return std::nullopt;
+
+    return std::chrono::hours{*hours} + std::chrono::minutes{*minutes};
+}
+
+std::optional<Options> parseOptions(const int argc, char* argv[])
+{
+    Options options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg{argv[i]};
+
+        const auto next = [&]() -> std::optional<std::string_view> {
+            if (i + 1 >= argc)
+                return std::nullopt;
+            return argv[++i];
+        };
+
+        if (arg == "--ascii")
+        {
+            options.ascii = true;
+        }
+        else if (arg == "--color")
+        {
+            options.ascii = true;
+            options.color = true;
+        }
+        else if (arg == "--frames" || arg == "--step")
+        {
+            const auto value = next().and_then(parseInt);
+            if (!value || *value < 0)
+                return std::nullopt;
+
+            if (arg == "--frames")
+                options.frames = *value;
+            else
+                options.step = std::chrono::milliseconds{*value};
+        }
+        else if (arg == "--animation")
+        {
+            const auto value = next();
+            if (!value)
+                return std::nullopt;
+
+            const auto animation = parseLedAnimationName(*value);
+            if (!animation)
+            {
+                std::cerr << animation.error() << '\n';
+                return std::nullopt;
+            }
+            options.animation = *animation;
+        }
+        else if (arg == "--time")
+        {
+            options.time = next().and_then(parseTime);
+            if (!options.time)
+                return std::nullopt;
+        }
+        else if (arg == "--text" || arg == "--raw")
+        {
+            const auto value = next();
+            if (!value)
+                return std::nullopt;
+
+            (arg == "--text" ? options.text : options.raw) = std::string{*value};
+        }
+        else
+        {
+            return std::nullopt;
+        }
+    }
+
+    return options;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const auto options = parseOptions(argc, argv);
+    if (!options)
+    {
+        usage();
+        return 1;
+    }
+
+    if (options->time)
+        sim::setLocalTime(std::chrono::sys_days{std::chrono::year{2024} / 6 / 15} + *options->time);
+
+    sim::begin();
+
+    if (options->animation)
+    {
+        if (const auto result = configutils::write_config(configs.ledAnimation, *options->animation); !result)
+        {
+            std::cerr << result.error() << '\n';
+            return 1;
+        }
+    }
+
+    if (options->text)
+    {
+        if (const auto result = configutils::write_config(configs.ledOverrideDigits, *options->text); !result)
+        {
+            std::cerr << result.error() << '\n';
+            return 1;
+        }
+    }
+
+    std::ofstream rawFile;
+    std::ostream* raw{};
+    if (options->raw)
+    {
+        if (*options->raw == "-")
+        {
+            raw = &std::cout;
+        }
+        else
+        {
+            rawFile.open(*options->raw, std::ios::binary);
+            if (!rawFile)
+            {
+                std::cerr << "cannot open " << *options->raw << '\n';
+                return 1;
+            }
+            raw = &rawFile;
+        }
+    }
+
+    // the frames go to stdout unless the raw dump does
+    auto& text = raw == &std::cout ? std::cerr : std::cout;
+
+    // the device renders its first frame at boot, before any interval elapsed
+    std::chrono::microseconds next{0};
+
+    for (int frame = 0; frame < options->frames; ++frame)
+    {
+        const auto elapsed = options->step.count() ? options->step : std::max(std::chrono::ceil<std::chrono::milliseconds>(next), 1ms);
+        next = sim::step(elapsed);
+
+        if (raw)
+            sim::writeRaw(*raw, sim::frame());
+
+        if (options->ascii)
+            text << sim::asciiFrame(sim::frame(), options->color) << '\n';
+    }
+
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include "simulator.h"
+
+// system includes
+#include <array>
+#include <format>
+#include <span>
+
+// 3rdparty lib includes
+#include <espchrono.h>
+#include <recursivelockhelper.h>
+
+// local includes
+#include "peripheral/ledhelpers/ledanimation.h"
+#include "peripheral/ledhelpers/ledlayout.h"
+#include "simclock.h"
+#include "utils/renderconfig.h"
+
+namespace sim {
+
+namespace {
+
+using Segment = SevenSegmentDigit::Segment;
+
+struct Cell
+{
+    bool lit{};
+    CRGB color{};
+};
+
+Cell cell(const std::span<const CRGB> leds)
+{
+    uint32_t red{}, green{}, blue{};
+    bool lit{};
+
+    for (const auto& led : leds)
+    {
+        red += led.r;
+        green += led.g;
+        blue += led.b;
+        lit |= led != CRGB{CRGB::Black};
+    }
+
+    const auto count = std::max<size_t>(leds.size(), 1);
+
+    return Cell{lit, CRGB{static_cast<uint8_t>(red / count), static_cast<uint8_t>(green / count), static_cast<uint8_t>(blue / count)}};
+}
+
+Cell segmentCell(const ledmanager::LedArray& leds, const size_t digit, const Segment segment)
+{
+    using ledlayout::layout;
+
+    const auto offset = layout.digitOffsets[digit] + ledlayout::segmentOffsets[segment];
+
+    return cell(std::span{leds}.subspan(offset, layout.ledsPerSegment));
+}
+
+Cell dotCell(const ledmanager::LedArray& leds, const size_t dot)
+{
+    using ledlayout::layout;
+
+    return cell(std::span{leds}.subspan(layout.dotOffsets[dot], layout.dotLength));
+}
+
+void draw(std::string& out, const Cell& cell, const char c, const bool color)
+{
+    if (!cell.lit)
+    {
+        out += ' ';
+        return;
+    }
+
+    if (color)
+        out += std::format("\x1b[38;2;{};{};{}m{}\x1b[0m", cell.color.r, cell.color.g, cell.color.b, c);
+    else
+        out += c;
+}
+
+// mirrors espclock::setTimeInLedManager()
+void setTimeDigits()
+{
+    if (renderconfig::get().overrideDigitsActive)
+        return;
+
+    const auto animation = animation::currentAnimation;
+    if (!animation || !animation->shouldSetDigits())
+        return;
+
+    const auto now = espchrono::toDateTime(espchrono::local_clock::now());
+
+    auto& digits = ledmanager::ledManager->digits;
+    digits[0].setDigit(now.hour / 10);
+    digits[1].setDigit(now.hour % 10);
+    digits[2].setDigit(now.minute / 10);
+    digits[3].setDigit(now.minute % 10);
+}
+
+} // namespace
+
+void begin()
+{
+    ledmanager::begin();
+}
+
+void setLocalTime(const std::chrono::sys_time<std::chrono::milliseconds> localTime)
+{
+    simclock::setLocalTime(localTime);
+}
+
+std::chrono::microseconds step(const std::chrono::milliseconds elapsed)
+{
+    simclock::advance(elapsed);
+
+    {
+        espcpputils::RecursiveLockHelper guard{ledmanager::led_lock->handle};
+        setTimeDigits();
+    }
+
+    return ledmanager::runFrame();
+}
+
+const ledmanager::LedArray& frame()
+{
+    return ledmanager::getLeds();
+}
+
+std::string asciiFrame(const ledmanager::LedArray& leds, const bool color)
+{
+    //  _   _     _   _
+    // |_| |_| . |_| |_|
+    // |_| |_| . |_| |_|
+    std::array<std::string, 3> rows;
+
+    for (size_t digit = 0; digit < ledlayout::DIGIT_COUNT; ++digit)
+    {
+        const auto segment = [&](const Segment s) { return segmentCell(leds, digit, s); };
+
+        rows[0] += ' ';
+        draw(rows[0], segment(Segment::A), '_', color);
+        rows[0] += "  ";
+
+        draw(rows[1], segment(Segment::F), '|', color);
+        draw(rows[1], segment(Segment::G), '_', color);
+        draw(rows[1], segment(Segment::B), '|', color);
+        rows[1] += ' ';
+
+        draw(rows[2], segment(Segment::E), '|', color);
+        draw(rows[2], segment(Segment::D), '_', color);
+        draw(rows[2], segment(Segment::C), '|', color);
+        rows[2] += ' ';
+
+        // the dots sit between hours and minutes
+        if (digit == 1)
+        {
+            rows[0] += "  ";
+            draw(rows[1], dotCell(leds, 0), '.', color);
+            rows[1] += ' ';
+            draw(rows[2], dotCell(leds, 1), '.', color);
+            rows[2] += ' ';
+        }
+    }
+
+    return rows[0] + '\n' + rows[1] + '\n' + rows[2] + '\n';
+}
+
+void writeRaw(std::ostream& stream, const ledmanager::LedArray& leds)
+{
+    for (const auto& led : leds)
+    {
+        stream.put(static_cast<char>(led.r));
+        stream.put(static_cast<char>(led.g));
+        stream.put(static_cast<char>(led.b));
+    }
+}
+
+} // namespace sim
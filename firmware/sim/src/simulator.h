@@ -0,0 +1,35 @@
+#pragma once
+
+// system includes
+#include <chrono>
+#include <ostream>
+#include <string>
+
+// local includes
+#include "peripheral/ledmanager.h"
+
+// Drives the real render path on a host. Tasks and timers never run, every step advances the
+// simulated clock and renders one frame the way the render task does on the device.
+namespace sim {
+
+// sets up the led manager, the configs start out at their defaults
+void begin();
+
+// sets the wall clock shown by the digits
+void setLocalTime(std::chrono::sys_time<std::chrono::milliseconds> localTime);
+
+// advances the simulated time, sets hh:mm like espclock does and renders one frame,
+// returns the delay the governor picked until the next frame
+std::chrono::microseconds step(std::chrono::milliseconds elapsed);
+
+// composed frame before brightness, gamma and power limiting
+const ledmanager::LedArray& frame();
+
+// four digits and the dots drawn with | and _, a segment counts as lit when one of its leds is,
+// color adds the average segment color as 24 bit ansi escapes
+std::string asciiFrame(const ledmanager::LedArray& leds, bool color);
+
+// HARDWARE_WS2812B_COUNT rgb triplets in strip order
+void writeRaw(std::ostream& stream, const ledmanager::LedArray& leds);
+
+} // namespace sim
@@ -0,0 +1,59 @@
+// Host replacements for the subsystems the render path asks about. The clock counts as
+// synced, there is no ota running and no realtime sender.
+
+// 3rdparty lib includes
+#include <configmanager.h>
+
+// local includes
+#include "communication/ota.h"
+#include "communication/realtime.h"
+#include "utils/config.h"
+#include "utils/espclock.h"
+
+std::string defaultHostname()
+{
+    return "ws2812-clock";
+}
+
+ConfigManager<ConfigContainer> configs;
+
+namespace ota {
+
+bool isInProgress()
+{
+    return false;
+}
+
+float percent()
+{
+    return 0.f;
+}
+
+} // namespace ota
+
+namespace realtime {
+
+bool active()
+{
+    return false;
+}
+
+void frameShown()
+{
+}
+
+} // namespace realtime
+
+namespace espclock {
+
+bool isSynced()
+{
+    return true;
+}
+
+bool isNight()
+{
+    return false;
+}
+
+} // namespace espclock
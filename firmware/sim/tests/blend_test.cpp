@@ -0,0 +1,76 @@
+// system includes
+#include <array>
+#include <cstdint>
+
+// 3rdparty lib includes
+#include <gtest/gtest.h>
+
+// local includes
+#include "peripheral/ledhelpers/blend.h"
+
+namespace {
+
+// odd length, so the byte tail after the last full word is covered as well
+constexpr size_t length = 11;
+
+using Leds = std::array<CRGB, length>;
+
+Leds pattern(const uint8_t seed)
+{
+    Leds leds;
+    for (size_t i = 0; i < leds.size(); ++i)
+    {
+        for (size_t channel = 0; channel < 3; ++channel)
+        {
+            leds[i].raw[channel] = seed + i * 37 + channel * 101;
+        }
+    }
+
+    // the extremes are where a carry into the neighbouring byte would show
+    leds[0] = CRGB{255, 255, 255};
+    leds[1] = CRGB{0, 0, 0};
+
+    return leds;
+}
+
+uint8_t scalarBlend(const uint8_t from, const uint8_t to, const uint16_t amount)
+{
+    return (from * (256 - amount) + to * amount) >> 8;
+}
+
+} // namespace
+
+TEST(BlendLeds, MatchesScalarFormulaForEveryAmount)
+{
+    const auto from = pattern(3);
+    const auto to = pattern(200);
+
+    for (uint16_t amount = 0; amount <= 256; ++amount)
+    {
+        Leds out;
+        blendLeds(from.data(), to.data(), out.data(), length, amount);
+
+        for (size_t i = 0; i < length; ++i)
+        {
+            for (size_t channel = 0; channel < 3; ++channel)
+            {
+                ASSERT_EQ(out[i].raw[channel], scalarBlend(from[i].raw[channel], to[i].raw[channel], amount))
+                    << "amount " << amount << " led " << i << " channel " << channel;
+            }
+        }
+    }
+}
+
+TEST(BlendLeds, OutMayAliasFrom)
+{
+    const auto from = pattern(17);
+    const auto to = pattern(90);
+
+    Leds expected;
+    blendLeds(from.data(), to.data(), expected.data(), length, 100);
+
+    auto inPlace = from;
+    blendLeds(inPlace.data(), to.data(), inPlace.data(), length, 100);
+
+    EXPECT_EQ(inPlace, expected);
+}
@@ -0,0 +1,120 @@
+// system includes
+#include <memory>
+
+// 3rdparty lib includes
+#include <gtest/gtest.h>
+
+// local includes
+#include "peripheral/ledhelpers/compositor.h"
+
+namespace {
+
+// the stack as LedManager sets it up: base, multiply mask, additive notification, hidden system layer
+std::unique_ptr<Compositor> makeCompositor()
+{
+    auto compositor = std::make_unique<Compositor>();
+
+    compositor->setBlendMode(CompositorLayer::Digits, BlendMode::Multiply);
+    compositor->setBlendMode(CompositorLayer::Notification, BlendMode::Add);
+    compositor->setOpacity(CompositorLayer::Notification, 0);
+    compositor->setOpacity(CompositorLayer::System, 0);
+
+    compositor->pixels(CompositorLayer::Base).fill(CRGB{200, 100, 50});
+    compositor->pixels(CompositorLayer::Digits).fill(CRGB::White);
+
+    return compositor;
+}
+
+} // namespace
+
+TEST(Compositor, MultiplyMaskAtPartialOpacity)
+{
+    auto compositor = makeCompositor();
+    auto& mask = compositor->pixels(CompositorLayer::Digits);
+    mask[0] = CRGB::Black;
+    mask[1] = CRGB{128, 128, 128};
+
+    Compositor::Pixels out;
+
+    compositor->setOpacity(CompositorLayer::Digits, 128);
+    ASSERT_TRUE(compositor->compose(out.data()));
+
+    // half way between the base and black
+    EXPECT_EQ(out[0], (CRGB{100, 50, 25}));
+    EXPECT_EQ(out[1], (CRGB{150, 75, 37}));
+    // white leaves the base as it is at any opacity
+    EXPECT_EQ(out[2], (CRGB{200, 100, 50}));
+
+    compositor->setOpacity(CompositorLayer::Digits, 255);
+    ASSERT_TRUE(compositor->compose(out.data()));
+
+    EXPECT_EQ(out[0], (CRGB{0, 0, 0}));
+    EXPECT_EQ(out[2], (CRGB{200, 100, 50}));
+}
+
+TEST(Compositor, AddAndLightenScaleTheLayer)
+{
+    auto compositor = makeCompositor();
+    compositor->pixels(CompositorLayer::Base).fill(CRGB{100, 100, 100});
+    compositor->pixels(CompositorLayer::Notification).fill(CRGB{100, 200, 0});
+    compositor->setOpacity(CompositorLayer::Notification, 128);
+
+    Compositor::Pixels out;
+
+    ASSERT_TRUE(compositor->compose(out.data()));
+    EXPECT_EQ(out[0], (CRGB{151, 201, 100}));
+
+    compositor->setBlendMode(CompositorLayer::Notification, BlendMode::Lighten);
+    ASSERT_TRUE(compositor->compose(out.data()));
+    EXPECT_EQ(out[0], (CRGB{100, 101, 100}));
+}
+
+TEST(Compositor, ComposesOnlyWhenSomethingChanged)
+{
+    auto compositor = makeCompositor();
+
+    Compositor::Pixels out;
+
+    ASSERT_TRUE(compositor->compose(out.data()));
+    EXPECT_FALSE(compositor->compose(out.data()));
+
+    compositor->markDirty(CompositorLayer::Base);
+    EXPECT_TRUE(compositor->compose(out.data()));
+
+    out.fill(CRGB::Black);
+    compositor->invalidate();
+    ASSERT_TRUE(compositor->compose(out.data()));
+    EXPECT_EQ(out[0], (CRGB{200, 100, 50}));
+}
+
+TEST(Compositor, CoveredLayerStaysDirtyUntilUncovered)
+{
+    auto compositor = makeCompositor();
+
+    Compositor::Pixels out;
+
+    compositor->setBlendMode(CompositorLayer::System, BlendMode::Normal);
+    compositor->setOpacity(CompositorLayer::System, 255);
+    compositor->pixels(CompositorLayer::System).fill(CRGB::Blue);
+
+    EXPECT_TRUE(compositor->covered(CompositorLayer::Base));
+    EXPECT_TRUE(compositor->covered(CompositorLayer::Notification));
+    EXPECT_FALSE(compositor->covered(CompositorLayer::System));
+
+    ASSERT_TRUE(compositor->compose(out.data()));
+    EXPECT_EQ(out[0], CRGB{CRGB::Blue});
+
+    // repainted under the cover, nothing visible changes yet
+    compositor->pixels(CompositorLayer::Base).fill(CRGB::Red);
+    compositor->markDirty(CompositorLayer::Base);
+    EXPECT_FALSE(compositor->compose(out.data()));
+    EXPECT_TRUE(compositor->dirty(CompositorLayer::Base));
+
+    // a hidden layer covers nothing
+    compositor->setOpacity(CompositorLayer::System, 0);
+    EXPECT_FALSE(compositor->covered(CompositorLayer::Base));
+
+    ASSERT_TRUE(compositor->compose(out.data()));
+    EXPECT_EQ(out[0], CRGB{CRGB::Red});
+    EXPECT_FALSE(compositor->dirty(CompositorLayer::Base));
+}
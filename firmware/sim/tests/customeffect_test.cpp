@@ -0,0 +1,46 @@
+// system includes
+#include <algorithm>
+#include <chrono>
+
+// 3rdparty lib includes
+#include <gtest/gtest.h>
+
+// local includes
+#include "simulator.h"
+#include "utils/config.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+bool anyLed(const auto& predicate)
+{
+    return std::ranges::any_of(sim::frame(), predicate);
+}
+
+} // namespace
+
+TEST(CustomEffect, PicksUpNewProgramAfterConfigWrite)
+{
+    sim::begin();
+
+    ASSERT_TRUE(configutils::write_config(configs.animationTransitionDuration, 0));
+    ASSERT_TRUE(configutils::write_config(configs.ledAnimation, LedAnimationName::CustomEffect));
+
+    // rgb(1, 0, 0)
+    ASSERT_TRUE(configutils::write_config(configs.customEffect, "0100" "0201" "0200" "0200" "40"));
+
+    for (int i = 0; i < 5; ++i)
+        sim::step(50ms);
+
+    EXPECT_TRUE(anyLed([](const CRGB& led) { return led.r > 200 && led.g == 0 && led.b == 0; }));
+
+    // rgb(0, 1, 0)
+    ASSERT_TRUE(configutils::write_config(configs.customEffect, "0100" "0200" "0201" "0200" "40"));
+
+    for (int i = 0; i < 5; ++i)
+        sim::step(50ms);
+
+    EXPECT_TRUE(anyLed([](const CRGB& led) { return led.g > 200 && led.r == 0 && led.b == 0; }));
+    EXPECT_FALSE(anyLed([](const CRGB& led) { return led.r > 0; }));
+}
@@ -0,0 +1,113 @@
+// system includes
+#include <cstdint>
+#include <map>
+#include <string_view>
+
+// 3rdparty lib includes
+#include <gtest/gtest.h>
+
+// local includes
+#include "peripheral/ledhelpers/digithelper.h"
+
+using namespace digithelper;
+
+namespace {
+
+// the std::map lookup the constexpr table replaced, kept verbatim as the reference
+const std::map<char, uint8_t> LEGACY_SEGMENT_MASKS = {
+    {'0', A | B | C | D | E | F},
+    {'1', B | C},
+    {'2', A | B | D | E | G},
+    {'3', A | B | C | D | G},
+    {'4', B | C | F | G},
+    {'5', A | C | D | F | G},
+    {'6', A | C | D | E | F | G},
+    {'7', A | B | C},
+    {'8', A | B | C | D | E | F | G},
+    {'9', A | B | C | D | F | G},
+    {'A', A | B | C | E | F | G},
+    {'B', C | D | E | F | G},
+    {'C', A | D | E | F},
+    {'D', B | C | D | E | G},
+    {'E', A | D | E | F | G},
+    {'F', A | E | F | G},
+    {'G', A | C | D | E | F},
+    {'H', B | C | E | F | G},
+    {'I', B | C},
+    {'J', B | C | D | E},
+    {'K', E | F | G},
+    {'L', D | E | F},
+    {'M', A | C | E},
+    {'N', C | E | G},
+    {'O', A | B | C | D | E | F},
+    {'P', A | B | E | F | G},
+    {'Q', A | B | C | F | G},
+    {'R', E | G},
+    {'S', A | C | D | F | G},
+    {'T', D | E | F | G},
+    {'U', B | C | D | E | F},
+    {'V', C | D | E},
+    {'W', B | D | F},
+    {'X', B | C | E | F | G},
+    {'Y', B | C | D | F | G},
+    {'Z', A | B | D | E | G},
+    {' ', 0},
+    {'-', G},
+    {'_', D},
+};
+
+uint8_t legacyGetSegmentMask(const char c)
+{
+    const bool isLowercase = c >= 'a' && c <= 'z';
+
+    if (const auto it = LEGACY_SEGMENT_MASKS.find(c); it != LEGACY_SEGMENT_MASKS.end())
+        return it->second;
+
+    if (const auto it = LEGACY_SEGMENT_MASKS.find(isLowercase ? c - 32 : c + 32); it != LEGACY_SEGMENT_MASKS.end())
+        return it->second;
+
+    return 0;
+}
+
+// The old lookup folded every character that is not a lowercase letter by adding 32, which turned
+// punctuation and control characters into letters, digits, '-' or '_'. The table leaves them
+// blank on purpose. setText() and the marquee only ever pass alphanumerics and spaces.
+constexpr std::string_view INTENTIONALLY_BLANK =
+    "\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19" // -> '0'..'9'
+    "\r"                                       // -> '-'
+    "!\"#$%&'()*+,./:"                         // -> 'A'..'Z', '-' is in the table itself
+    "?";                                       // -> '_'
+
+} // namespace
+
+TEST(DigitHelper, MatchesLegacyMapForEveryCharacter)
+{
+    for (int i = 0; i < 256; ++i)
+    {
+        const auto c = static_cast<char>(i);
+
+        if (INTENTIONALLY_BLANK.find(c) != std::string_view::npos)
+            continue;
+
+        EXPECT_EQ(getSegmentMask(c), legacyGetSegmentMask(c)) << "character " << i;
+    }
+}
+
+TEST(DigitHelper, LegacyFoldingOnlyDivergesWhereDocumented)
+{
+    for (const auto c : INTENTIONALLY_BLANK)
+    {
+        EXPECT_EQ(getSegmentMask(c), 0) << "character " << int(c);
+        EXPECT_NE(legacyGetSegmentMask(c), 0) << "character " << int(c);
+    }
+}
+
+TEST(DigitHelper, FoldsLowercaseLetters)
+{
+    for (char c = 'a'; c <= 'z'; ++c)
+    {
+        EXPECT_EQ(getSegmentMask(c), getSegmentMask(c - 'a' + 'A')) << c;
+        EXPECT_EQ(getSegmentMask(c), legacyGetSegmentMask(c)) << c;
+        EXPECT_NE(getSegmentMask(c), 0) << c;
+    }
+}
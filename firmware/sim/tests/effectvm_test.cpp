@@ -0,0 +1,58 @@
+// system includes
+#include <string_view>
+
+// 3rdparty lib includes
+#include <gtest/gtest.h>
+
+// local includes
+#include "peripheral/ledhelpers/effectvm.h"
+
+namespace {
+
+CRGB runProgram(const std::string_view hex)
+{
+    const auto program = effectvm::parse(hex);
+    EXPECT_TRUE(program.has_value()) << (program ? "" : program.error());
+    if (!program)
+        return CRGB{CRGB::Black};
+
+    return effectvm::run(*program, effectvm::Inputs{}, effectvm::Palette{});
+}
+
+// value of the program without the trailing output, channels show whether it wrapped negative
+std::string withOutput(const std::string_view code)
+{
+    // red = value, green and blue = 1
+    return std::string{"0100"} + std::string{code} + "0201" "0201" "40";
+}
+
+} // namespace
+
+TEST(EffectVm, IntMinModuloMinusOneIsZero)
+{
+    // INT32_MIN % -1, traps on x86 when evaluated as int
+    EXPECT_EQ(runProgram(withOutput("0100000080" "01ffffffff" "24")).r, 0);
+}
+
+TEST(EffectVm, AddWrapsAround)
+{
+    // INT32_MAX + 1 wraps to INT32_MIN, which clamps to 0
+    EXPECT_EQ(runProgram(withOutput("01ffffff7f" "0100000100" "20")).r, 0);
+    // INT32_MIN - 1 wraps to INT32_MAX, which clamps to 255
+    EXPECT_EQ(runProgram(withOutput("0100000080" "0100000100" "21")).r, 255);
+}
+
+TEST(EffectVm, NegAndAbsOfIntMinStayIntMin)
+{
+    EXPECT_EQ(runProgram(withOutput("0100000080" "25")).r, 0);
+    EXPECT_EQ(runProgram(withOutput("0100000080" "26")).r, 0);
+}
+
+TEST(EffectVm, NegAndAbsOfOrdinaryValues)
+{
+    // -(-1) and abs(-1) are 1
+    EXPECT_EQ(runProgram(withOutput("010000ffff" "25")).r, 255);
+    EXPECT_EQ(runProgram(withOutput("010000ffff" "26")).r, 255);
+    // -(1) clamps to 0
+    EXPECT_EQ(runProgram(withOutput("0201" "25")).r, 0);
+}
@@ -0,0 +1,43 @@
+// system includes
+#include <chrono>
+
+// 3rdparty lib includes
+#include <gtest/gtest.h>
+
+// local includes
+#include "simulator.h"
+#include "utils/config.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+uint32_t stageCount(const RenderStage stage)
+{
+    return ledmanager::renderStats().stages[static_cast<size_t>(stage)].count();
+}
+
+} // namespace
+
+TEST(LedManager, BlinkingDotsDoNotRepaintTheAnimation)
+{
+    sim::setLocalTime(std::chrono::sys_days{std::chrono::year{2024} / 6 / 15} + 13h + 37min);
+    sim::begin();
+
+    ASSERT_TRUE(configutils::write_config(configs.animationTransitionDuration, 0));
+    ASSERT_TRUE(configutils::write_config(configs.disableDotBlinking, false));
+    // updates every 48ms, the dots toggle every 500ms in between
+    ASSERT_TRUE(configutils::write_config(configs.ledAnimation, LedAnimationName::Strobo));
+
+    for (int i = 0; i < 10; ++i)
+        sim::step(2ms);
+
+    const auto renders = stageCount(RenderStage::Render);
+    const auto updates = stageCount(RenderStage::AnimationUpdate);
+
+    // two blink edges, no digit changes
+    for (int i = 0; i < 600; ++i)
+        sim::step(2ms);
+
+    EXPECT_EQ(stageCount(RenderStage::Render) - renders, stageCount(RenderStage::AnimationUpdate) - updates);
+}
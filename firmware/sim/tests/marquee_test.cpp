@@ -0,0 +1,104 @@
+// system includes
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+// 3rdparty lib includes
+#include <gtest/gtest.h>
+
+// local includes
+#include "peripheral/ledhelpers/digithelper.h"
+#include "peripheral/ledhelpers/marquee.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+using Window = std::array<uint8_t, 4>;
+
+constexpr espchrono::milliseconds32 stepInterval{300};
+
+const espchrono::millis_clock::time_point start{10s};
+
+Window mask(const char (&text)[5])
+{
+    Window window;
+    for (size_t i = 0; i < window.size(); ++i)
+        window[i] = text[i] == ' ' ? 0 : digithelper::getSegmentMask(text[i]);
+    return window;
+}
+
+// "HELLO" plus four blanks, nine steps per pass
+Marquee hello()
+{
+    Marquee marquee;
+    EXPECT_TRUE(marquee.start("HELLO", 4, start));
+    return marquee;
+}
+
+std::optional<Window> windowAt(const Marquee& marquee, const size_t step, const uint8_t loops = 0)
+{
+    Window window;
+    if (!marquee.window(start + step * stepInterval, stepInterval, loops, window))
+        return std::nullopt;
+    return window;
+}
+
+} // namespace
+
+TEST(Marquee, TextEntersFromTheRight)
+{
+    const auto marquee = hello();
+
+    EXPECT_EQ(windowAt(marquee, 0), mask("   H"));
+    EXPECT_EQ(windowAt(marquee, 3), mask("HELL"));
+    EXPECT_EQ(windowAt(marquee, 4), mask("ELLO"));
+    EXPECT_EQ(windowAt(marquee, 8), mask("    "));
+}
+
+TEST(Marquee, WrapsAroundForever)
+{
+    const auto marquee = hello();
+
+    for (size_t step = 0; step < 9; ++step)
+    {
+        EXPECT_EQ(windowAt(marquee, step + 9), windowAt(marquee, step)) << step;
+        EXPECT_EQ(windowAt(marquee, step + 9 * 100), windowAt(marquee, step)) << step;
+    }
+}
+
+TEST(Marquee, StopsAfterTheLoopCount)
+{
+    const auto marquee = hello();
+
+    EXPECT_TRUE(windowAt(marquee, 8, 1));
+    EXPECT_FALSE(windowAt(marquee, 9, 1));
+
+    EXPECT_EQ(windowAt(marquee, 17, 2), mask("    "));
+    EXPECT_FALSE(windowAt(marquee, 18, 2));
+}
+
+TEST(Marquee, RestartingTheSameTextKeepsThePosition)
+{
+    auto marquee = hello();
+
+    EXPECT_FALSE(marquee.start("HELLO", 4, start + 3 * stepInterval));
+    EXPECT_EQ(windowAt(marquee, 3), mask("HELL"));
+
+    EXPECT_TRUE(marquee.start("WORLD", 4, start + 3 * stepInterval));
+    EXPECT_EQ(windowAt(marquee, 3), mask("   W"));
+
+    marquee.stop();
+    EXPECT_FALSE(marquee.active());
+    EXPECT_FALSE(windowAt(marquee, 3));
+}
+
+TEST(Marquee, UntilNextStep)
+{
+    const auto marquee = hello();
+
+    EXPECT_EQ(marquee.untilNextStep(start, stepInterval), stepInterval);
+    EXPECT_EQ(marquee.untilNextStep(start + 250ms, stepInterval), 50ms);
+    EXPECT_EQ(marquee.untilNextStep(start + 2 * stepInterval + 1ms, stepInterval), 299ms);
+}
@@ -0,0 +1,238 @@
+// system includes
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 3rdparty lib includes
+#include <gtest/gtest.h>
+
+// local includes
+#include "communication/realtimeprotocol.h"
+
+using namespace realtime;
+
+namespace {
+
+constexpr size_t LED_COUNT = 4;
+
+using Leds = std::array<uint8_t, LED_COUNT * 3>;
+
+std::string bytes(std::initializer_list<uint8_t> values)
+{
+    return std::string{values.begin(), values.end()};
+}
+
+void appendU16(std::string& packet, const uint16_t value)
+{
+    packet += char(value >> 8);
+    packet += char(value);
+}
+
+std::string ddp(const uint8_t flags, const uint8_t sequence, const uint32_t offset, const std::string& data)
+{
+    auto packet = bytes({ flags, sequence, 0x01, 0x01 });
+    appendU16(packet, offset >> 16);
+    appendU16(packet, offset);
+    appendU16(packet, data.size());
+    return packet + data;
+}
+
+// data packet with the start code and data as dmx property values
+std::string e131(const uint16_t universe, const uint8_t sequence, const uint8_t options, const std::string& data)
+{
+    std::string packet(126, '\0');
+
+    packet[1] = 0x10;
+    packet.replace(4, 12, std::string{"ASC-E1.17\0\0\0", 12});
+    packet[21] = 0x04;
+    packet[43] = 0x02;
+    packet[111] = char(sequence);
+    packet[112] = char(options);
+    packet[113] = char(universe >> 8);
+    packet[114] = char(universe);
+    packet[117] = 0x02;
+    packet[118] = char(0xa1);
+    packet[123] = char((data.size() + 1) >> 8);
+    packet[124] = char(data.size() + 1);
+
+    return packet + data;
+}
+
+} // namespace
+
+TEST(RealtimeDdp, WritesPayloadAtOffset)
+{
+    Leds leds{};
+
+    const auto frame = decode(Protocol::Ddp, ddp(0x41, 3, 3, bytes({ 1, 2, 3, 4, 5, 6 })), leds.data(), LED_COUNT, 1);
+
+    ASSERT_TRUE(frame.has_value()) << frame.error();
+    EXPECT_EQ(frame->firstLed, 1u);
+    EXPECT_EQ(frame->ledCount, 2u);
+    EXPECT_EQ(frame->sequence, 3);
+    EXPECT_TRUE(frame->push);
+    EXPECT_EQ(leds, (Leds{ 0, 0, 0, 1, 2, 3, 4, 5, 6, 0, 0, 0 }));
+}
+
+TEST(RealtimeDdp, RejectsTruncatedPackets)
+{
+    Leds leds{};
+
+    EXPECT_FALSE(decode(Protocol::Ddp, bytes({ 0x41, 0, 0x01, 0x01, 0, 0, 0, 0, 0 }), leds.data(), LED_COUNT, 1));
+
+    // the length field claims more than the packet holds
+    auto packet = ddp(0x41, 0, 0, bytes({ 1, 2, 3 }));
+    packet.pop_back();
+    EXPECT_FALSE(decode(Protocol::Ddp, packet, leds.data(), LED_COUNT, 1));
+
+    EXPECT_EQ(leds, Leds{});
+}
+
+TEST(RealtimeDdp, ClipsToTheStrip)
+{
+    Leds leds{};
+
+    const auto outside = decode(Protocol::Ddp, ddp(0x41, 0, LED_COUNT * 3, bytes({ 1, 2, 3 })), leds.data(), LED_COUNT, 1);
+    ASSERT_TRUE(outside.has_value());
+    EXPECT_EQ(outside->ledCount, 0u);
+    EXPECT_EQ(leds, Leds{});
+
+    const auto partly = decode(Protocol::Ddp, ddp(0x41, 0, 9, bytes({ 1, 2, 3, 4, 5, 6 })), leds.data(), LED_COUNT, 1);
+    ASSERT_TRUE(partly.has_value());
+    EXPECT_EQ(partly->firstLed, 3u);
+    EXPECT_EQ(partly->ledCount, 1u);
+    EXPECT_EQ(leds, (Leds{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3 }));
+}
+
+TEST(RealtimeDdp, SequenceWrapsFrom15To1)
+{
+    EXPECT_EQ(lostBetween(Protocol::Ddp, 1, 2), 0);
+    EXPECT_EQ(lostBetween(Protocol::Ddp, 15, 1), 0);
+    EXPECT_EQ(lostBetween(Protocol::Ddp, 14, 2), 2);
+}
+
+TEST(RealtimeDdp, RepeatedOrUncountedSequenceLosesNothing)
+{
+    EXPECT_EQ(lostBetween(Protocol::Ddp, 5, 5), 0);
+    EXPECT_EQ(lostBetween(Protocol::Ddp, 0, 3), 0);
+    EXPECT_EQ(lostBetween(Protocol::Ddp, 3, 0), 0);
+
+    Leds leds{};
+    const auto frame = decode(Protocol::Ddp, ddp(0x41, 0, 0, bytes({ 1, 2, 3 })), leds.data(), LED_COUNT, 1);
+    ASSERT_TRUE(frame.has_value());
+    EXPECT_FALSE(frame->sequence);
+}
+
+TEST(RealtimeE131, WritesUniverseAndPushesTheLastOne)
+{
+    Leds leds{};
+
+    const auto frame = decode(Protocol::E131, e131(7, 42, 0, bytes({ 1, 2, 3, 4, 5, 6 })), leds.data(), LED_COUNT, 7);
+
+    ASSERT_TRUE(frame.has_value()) << frame.error();
+    EXPECT_EQ(frame->firstLed, 0u);
+    EXPECT_EQ(frame->ledCount, 2u);
+    EXPECT_EQ(frame->sequence, 42);
+    EXPECT_EQ(frame->universe, 7);
+    EXPECT_TRUE(frame->push);
+    EXPECT_EQ(leds, (Leds{ 1, 2, 3, 4, 5, 6, 0, 0, 0, 0, 0, 0 }));
+}
+
+TEST(RealtimeE131, RejectsTruncatedPackets)
+{
+    Leds leds{};
+
+    auto packet = e131(1, 0, 0, {});
+    packet.pop_back();
+    EXPECT_FALSE(decode(Protocol::E131, packet, leds.data(), LED_COUNT, 1));
+
+    // the property count claims more than the packet holds
+    packet = e131(1, 0, 0, bytes({ 1, 2, 3 }));
+    packet.pop_back();
+    EXPECT_FALSE(decode(Protocol::E131, packet, leds.data(), LED_COUNT, 1));
+
+    EXPECT_EQ(leds, Leds{});
+}
+
+TEST(RealtimeE131, UniversesOutsideTheStrip)
+{
+    Leds leds{};
+
+    EXPECT_FALSE(decode(Protocol::E131, e131(1, 0, 0, bytes({ 1, 2, 3 })), leds.data(), LED_COUNT, 2));
+
+    const auto frame = decode(Protocol::E131, e131(3, 0, 0, bytes({ 1, 2, 3 })), leds.data(), LED_COUNT, 2);
+    ASSERT_TRUE(frame.has_value());
+    EXPECT_EQ(frame->ledCount, 0u);
+    EXPECT_FALSE(frame->push);
+
+    EXPECT_EQ(leds, Leds{});
+}
+
+TEST(RealtimeE131, TerminatedStream)
+{
+    Leds leds{};
+
+    const auto frame = decode(Protocol::E131, e131(1, 0, 0x40, bytes({ 1, 2, 3 })), leds.data(), LED_COUNT, 1);
+    ASSERT_TRUE(frame.has_value());
+    EXPECT_TRUE(frame->terminate);
+    EXPECT_EQ(leds, Leds{});
+}
+
+TEST(RealtimeE131, SequenceWrapsAndLatePacketsAreNotLost)
+{
+    EXPECT_EQ(lostBetween(Protocol::E131, 255, 0), 0);
+    EXPECT_EQ(lostBetween(Protocol::E131, 254, 1), 2);
+    EXPECT_EQ(lostBetween(Protocol::E131, 10, 5), 0);
+    EXPECT_EQ(lostBetween(Protocol::E131, 10, 10), 0);
+}
+
+TEST(RealtimeWled, DrgbWritesFromTheStart)
+{
+    Leds leds{};
+
+    const auto frame = decode(Protocol::Wled, bytes({ 2, 5, 1, 2, 3, 4, 5, 6 }), leds.data(), LED_COUNT, 1);
+
+    ASSERT_TRUE(frame.has_value()) << frame.error();
+    EXPECT_EQ(frame->firstLed, 0u);
+    EXPECT_EQ(frame->ledCount, 2u);
+    EXPECT_EQ(frame->timeout, std::chrono::seconds{5});
+    EXPECT_TRUE(frame->push);
+    EXPECT_FALSE(frame->sequence);
+    EXPECT_EQ(leds, (Leds{ 1, 2, 3, 4, 5, 6, 0, 0, 0, 0, 0, 0 }));
+}
+
+TEST(RealtimeWled, RejectsTruncatedPackets)
+{
+    Leds leds{};
+
+    EXPECT_FALSE(decode(Protocol::Wled, bytes({ 2 }), leds.data(), LED_COUNT, 1));
+    // DNRGB without its start index
+    EXPECT_FALSE(decode(Protocol::Wled, bytes({ 4, 1, 0 }), leds.data(), LED_COUNT, 1));
+    EXPECT_FALSE(decode(Protocol::Wled, bytes({ 9, 1 }), leds.data(), LED_COUNT, 1));
+
+    EXPECT_EQ(leds, Leds{});
+}
+
+TEST(RealtimeWled, IndicesOutsideTheStripAreDropped)
+{
+    Leds leds{};
+
+    // WARLS, index 9 does not exist
+    const auto warls = decode(Protocol::Wled, bytes({ 1, 1, 9, 7, 7, 7, 2, 1, 2, 3 }), leds.data(), LED_COUNT, 1);
+    ASSERT_TRUE(warls.has_value());
+    EXPECT_EQ(warls->firstLed, 2u);
+    EXPECT_EQ(warls->ledCount, 1u);
+    EXPECT_EQ(leds, (Leds{ 0, 0, 0, 0, 0, 0, 1, 2, 3, 0, 0, 0 }));
+
+    // DNRGB starting past the end
+    const auto dnrgb = decode(Protocol::Wled, bytes({ 4, 1, 0, LED_COUNT, 7, 7, 7 }), leds.data(), LED_COUNT, 1);
+    ASSERT_TRUE(dnrgb.has_value());
+    EXPECT_EQ(dnrgb->ledCount, 0u);
+    EXPECT_EQ(leds, (Leds{ 0, 0, 0, 0, 0, 0, 1, 2, 3, 0, 0, 0 }));
+}
+
+TEST(RealtimeWled, HasNoSequence)
+{
+    EXPECT_EQ(lostBetween(Protocol::Wled, 1, 9), 0);
+}
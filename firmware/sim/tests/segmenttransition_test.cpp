@@ -0,0 +1,114 @@
+// system includes
+#include <chrono>
+#include <cstdint>
+
+// 3rdparty lib includes
+#include <gtest/gtest.h>
+
+// local includes
+#include "peripheral/ledhelpers/digithelper.h"
+#include "peripheral/ledhelpers/segmenttransition.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr espchrono::milliseconds32 duration{1000};
+
+const espchrono::millis_clock::time_point start{10s};
+
+// A stays lit, F turns off and G turns on, everything else stays dark
+SegmentTransition fromAfToAg()
+{
+    SegmentTransition transition;
+    transition.update(digithelper::A | digithelper::F, start - 5s);
+    transition.update(digithelper::A | digithelper::G, start);
+    return transition;
+}
+
+struct Expected
+{
+    uint8_t turningOff;
+    uint8_t turningOn;
+};
+
+void expectLevels(const DigitTransition style, const espchrono::milliseconds32 elapsed, const Expected expected)
+{
+    const auto levels = fromAfToAg().levels(style, start + elapsed, duration);
+
+    SCOPED_TRACE(testing::Message() << toString(style) << " at " << elapsed.count() << "ms");
+
+    EXPECT_EQ(levels[SevenSegmentDigit::A], 255);
+    EXPECT_EQ(levels[SevenSegmentDigit::F], expected.turningOff);
+    EXPECT_EQ(levels[SevenSegmentDigit::G], expected.turningOn);
+
+    for (const auto segment : { SevenSegmentDigit::B, SevenSegmentDigit::C, SevenSegmentDigit::D, SevenSegmentDigit::E })
+        EXPECT_EQ(levels[segment], 0);
+}
+
+} // namespace
+
+TEST(SegmentTransition, OffSwitchesRightAway)
+{
+    expectLevels(DigitTransition::Off, 0ms, { .turningOff = 0, .turningOn = 255 });
+    expectLevels(DigitTransition::Off, 500ms, { .turningOff = 0, .turningOn = 255 });
+    expectLevels(DigitTransition::Off, 1000ms, { .turningOff = 0, .turningOn = 255 });
+}
+
+TEST(SegmentTransition, CrossfadeMeetsHalfWay)
+{
+    expectLevels(DigitTransition::Crossfade, 0ms, { .turningOff = 255, .turningOn = 0 });
+    expectLevels(DigitTransition::Crossfade, 500ms, { .turningOff = 128, .turningOn = 127 });
+    expectLevels(DigitTransition::Crossfade, 1000ms, { .turningOff = 0, .turningOn = 255 });
+}
+
+TEST(SegmentTransition, FadeOutInIsDarkHalfWay)
+{
+    expectLevels(DigitTransition::FadeOutIn, 0ms, { .turningOff = 255, .turningOn = 0 });
+    expectLevels(DigitTransition::FadeOutIn, 500ms, { .turningOff = 0, .turningOn = 0 });
+    expectLevels(DigitTransition::FadeOutIn, 1000ms, { .turningOff = 0, .turningOn = 255 });
+}
+
+TEST(SegmentTransition, WipeRunsDownRowByRow)
+{
+    // F sits in the row above G, so it is further along half way
+    expectLevels(DigitTransition::Wipe, 0ms, { .turningOff = 255, .turningOn = 0 });
+    expectLevels(DigitTransition::Wipe, 500ms, { .turningOff = 64, .turningOn = 127 });
+    expectLevels(DigitTransition::Wipe, 1000ms, { .turningOff = 0, .turningOn = 255 });
+}
+
+TEST(SegmentTransition, RunsUntilTheDurationPassed)
+{
+    const auto transition = fromAfToAg();
+
+    EXPECT_TRUE(transition.running(start, duration));
+    EXPECT_TRUE(transition.running(start + 999ms, duration));
+    EXPECT_FALSE(transition.running(start + duration, duration));
+
+    // a zero duration finishes right away
+    EXPECT_FALSE(transition.running(start, espchrono::milliseconds32{0}));
+}
+
+TEST(SegmentTransition, SameMaskDoesNotRestart)
+{
+    auto transition = fromAfToAg();
+
+    transition.update(digithelper::A | digithelper::G, start + 500ms);
+
+    const auto levels = transition.levels(DigitTransition::Crossfade, start + 1000ms, duration);
+    EXPECT_EQ(levels[SevenSegmentDigit::G], 255);
+    EXPECT_FALSE(transition.running(start + 1000ms, duration));
+}
+
+TEST(SegmentTransition, NewMaskStartsFromTheLastTarget)
+{
+    auto transition = fromAfToAg();
+
+    // G was fading in, the new transition starts from A | G as if it had finished
+    transition.update(digithelper::A, start + 500ms);
+
+    const auto levels = transition.levels(DigitTransition::Crossfade, start + 500ms, duration);
+    EXPECT_EQ(levels[SevenSegmentDigit::A], 255);
+    EXPECT_EQ(levels[SevenSegmentDigit::F], 0);
+    EXPECT_EQ(levels[SevenSegmentDigit::G], 255);
+}
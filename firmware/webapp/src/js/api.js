@@ -4,10 +4,12 @@
  * GET  /api/v1/set
  * POST /api/v1/set
  * GET  /api/v1/leds
+ * GET  /api/v1/leds.bin (?since=<X-Frame>)
  * GET  /api/v1/tasks
  * GET  /api/v1/triggerOta (?url=)
  * GET  /api/v1/ota
  * GET  /api/v1/reboot
+ * WS   /api/v1/ws
  */
 
 const delay = ms => new Promise(resolve => setTimeout(resolve, ms));
@@ -33,12 +35,17 @@ export class ClockApi {
         this.status = null;
         this.config = null;
         this.leds = null;
+        this.ledsFrame = null;
         this.tasks = null;
         this.otastatus = null;
 
         // interval
         this.fetchInterval = null;
 
+        // push channel, polling only covers what it does not push while it is open
+        this.socket = null;
+        this.ledsInterval = 500;
+
         // callbacks
         this.onStatusChange = null;
         this.onConfigChange = null;
@@ -115,17 +122,95 @@ export class ClockApi {
         this.status = null;
         this.config = null;
         this.leds = null;
+        this.ledsFrame = null;
         this.tasks = null;
         this.animations = null;
         this.otastatus = null;
 
         this.fetchAll();
+        this.connectSocket();
 
         this.fetchInterval = setInterval(() => {
-            this.fetchAll();
+            if (this.socket?.readyState === WebSocket.OPEN)
+                this.fetchPolledOnly();
+            else
+                this.fetchAll();
         }, 5000);
     }
 
+    async fetchPolledOnly() {
+        try {
+            await this.fetchTasks();
+            await this.fetchOtaStatus();
+        } catch (e) {
+            console.error('fetch error', e);
+        }
+    }
+
+    connectSocket() {
+        const base = this.apiBase.startsWith('http')
+            ? this.apiBase.replace(/^http/, 'ws')
+            : `${window.location.protocol === 'https:' ? 'wss' : 'ws'}://${window.location.host}${this.apiBase}`;
+
+        const socket = new WebSocket(`${base}/ws`);
+        socket.binaryType = 'arraybuffer';
+
+        socket.onopen = () => {
+            socket.send(JSON.stringify({leds: this.ledsInterval}));
+        };
+
+        socket.onmessage = event => {
+            if (event.data instanceof ArrayBuffer)
+                this.handleLedFrame(new Uint8Array(event.data));
+            else
+                this.handleSocketMessage(JSON.parse(event.data));
+        };
+
+        socket.onclose = () => {
+            // back to polling until the clock is reachable again
+            this.socket = null;
+            setTimeout(() => this.connectSocket(), 5000);
+        };
+
+        this.socket = socket;
+    }
+
+    handleSocketMessage(message) {
+        switch (message.type) {
+            case 'status': {
+                // nested objects only carry the keys that changed, merge them instead of replacing
+                const status = {...this.status?.status};
+                for (const [key, value] of Object.entries(message.data)) {
+                    const isObject = value !== null && typeof value === 'object' && !Array.isArray(value);
+                    status[key] = isObject ? {...status[key], ...value} : value;
+                }
+                this.status = {...this.status, success: true, status};
+                if (this.onStatusChange)
+                    this.onStatusChange(this.status);
+                break;
+            }
+            case 'config':
+                this.config = {...this.config, ...message.data};
+                if (this.onConfigChange)
+                    this.onConfigChange(this.config);
+                break;
+        }
+    }
+
+    handleLedFrame(body) {
+        // preview frame (u32 le) followed by rgb
+        const frame = body[0] | (body[1] << 8) | (body[2] << 16) | (body[3] << 24);
+
+        const leds = [];
+        for (let offset = 4; offset + 3 <= body.length; offset += 3)
+            leds.push([body[offset], body[offset + 1], body[offset + 2]]);
+
+        this.leds = leds;
+        this.ledsFrame = frame >>> 0;
+        if (this.onLedsChange)
+            this.onLedsChange(this.leds);
+    }
+
     async fetchStatus() {
         const controller = new AbortController();
         setTimeout(() => controller.abort(), 3000);
@@ -158,8 +243,35 @@ export class ClockApi {
         setTimeout(() => controller.abort(), 3000);
 
         try {
-            const response = await fetch(`${this.apiBase}/leds`, {signal: controller.signal});
-            this.leds = await response.json();
+            const since = this.leds && this.ledsFrame !== null ? `?since=${this.ledsFrame}` : '';
+            const response = await fetch(`${this.apiBase}/leds.bin${since}`, {signal: controller.signal});
+            const body = new Uint8Array(await response.arrayBuffer());
+            // opaque <boot>-<frame> token, a counter from another boot gets a raw frame
+            const frame = response.headers.get('X-Frame');
+
+            if (response.headers.get('X-Frame-Encoding') === 'rle') {
+                if (this.ledsFrame === frame)
+                    return this.leds;
+
+                // runs of start (u16 le), count (u16 le) and count * rgb
+                const leds = [...this.leds];
+                for (let offset = 0; offset + 4 <= body.length;) {
+                    const start = body[offset] | (body[offset + 1] << 8);
+                    const count = body[offset + 2] | (body[offset + 3] << 8);
+                    offset += 4;
+
+                    for (let i = 0; i < count; i++, offset += 3)
+                        leds[start + i] = [body[offset], body[offset + 1], body[offset + 2]];
+                }
+                this.leds = leds;
+            } else {
+                const leds = [];
+                for (let offset = 0; offset + 3 <= body.length; offset += 3)
+                    leds.push([body[offset], body[offset + 1], body[offset + 2]]);
+                this.leds = leds;
+            }
+
+            this.ledsFrame = frame;
             if (this.onLedsChange)
                 this.onLedsChange(this.leds);
             return this.leds;